@@ -0,0 +1,185 @@
+/**
+ * @file AnilloCompartido.cpp
+ * @brief Implementación del anillo en memoria compartida (POSIX)
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "AnilloCompartido.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Los procesos comparten las variables atómicas: deben ser operaciones de
+// hardware, sin candados internos de la biblioteca
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && sizeof(uint64_t) == sizeof(long long),
+              "El anillo compartido necesita atomicos de 64 bits sin candados");
+static_assert(sizeof(RanuraAnillo) == 16, "Cada ranura ocupa 16 bytes");
+static_assert(sizeof(CabeceraAnillo) <= PRT7_INICIO_RANURAS, "La cabecera no cabe antes de las ranuras");
+
+PublicadorAnillo::PublicadorAnillo()
+    : cabecera(nullptr), ranuras(nullptr), mascara(0), siguiente(0), bytesMapeados(0) {}
+
+LectorAnillo::LectorAnillo()
+    : cabecera(nullptr), ranuras(nullptr), mascara(0), proximo(0), perdidos(0), bytesMapeados(0) {}
+
+#ifdef _WIN32
+
+// Sin shm_open: el anillo sólo está disponible en sistemas POSIX
+PublicadorAnillo::~PublicadorAnillo() {}
+
+bool PublicadorAnillo::crear(const char* nombre, size_t capacidadMinima) {
+    (void)nombre;
+    (void)capacidadMinima;
+    return false;
+}
+
+bool PublicadorAnillo::eliminar(const char* nombre) {
+    (void)nombre;
+    return false;
+}
+
+LectorAnillo::~LectorAnillo() {}
+
+bool LectorAnillo::abrir(const char* nombre, bool desdeInicio) {
+    (void)nombre;
+    (void)desdeInicio;
+    return false;
+}
+
+bool LectorAnillo::siguiente(EventoAnillo& evento) {
+    (void)evento;
+    return false;
+}
+
+#else
+
+PublicadorAnillo::~PublicadorAnillo() {
+    if (!cabecera) return;
+    cabecera->cerrado.store(1, std::memory_order_release);
+    munmap(cabecera, bytesMapeados);
+}
+
+bool PublicadorAnillo::crear(const char* nombre, size_t capacidadMinima) {
+    if (cabecera) return false;
+
+    uint64_t capacidad = 2;
+    while (capacidad < capacidadMinima) capacidad *= 2;
+    size_t bytes = PRT7_INICIO_RANURAS + capacidad * sizeof(RanuraAnillo);
+
+    // Un objeto nuevo: quien tenga mapeado el anterior no lo ve truncarse
+    shm_unlink(nombre);
+    int fd = shm_open(nombre, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd == -1) return false;
+    if (ftruncate(fd, (off_t)bytes) != 0) {
+        close(fd);
+        shm_unlink(nombre);
+        return false;
+    }
+    void* memoria = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memoria == MAP_FAILED) {
+        shm_unlink(nombre);
+        return false;
+    }
+
+    // ftruncate deja todo en cero: sólo falta la cabecera; la magia va al final
+    cabecera = static_cast<CabeceraAnillo*>(memoria);
+    ranuras = reinterpret_cast<RanuraAnillo*>(static_cast<char*>(memoria) + PRT7_INICIO_RANURAS);
+    mascara = capacidad - 1;
+    siguiente = 0;
+    bytesMapeados = bytes;
+    cabecera->formato = PRT7_FORMATO_ANILLO;
+    cabecera->capacidad = capacidad;
+    reinterpret_cast<std::atomic<uint32_t>*>(&cabecera->magia)->store(PRT7_MAGIA_ANILLO,
+                                                                        std::memory_order_release);
+    return true;
+}
+
+bool PublicadorAnillo::eliminar(const char* nombre) {
+    return shm_unlink(nombre) == 0;
+}
+
+LectorAnillo::~LectorAnillo() {
+    if (cabecera) munmap(const_cast<CabeceraAnillo*>(cabecera), bytesMapeados);
+}
+
+bool LectorAnillo::abrir(const char* nombre, bool desdeInicio) {
+    if (cabecera) return false;
+
+    int fd = shm_open(nombre, O_RDONLY, 0);
+    if (fd == -1) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < PRT7_INICIO_RANURAS) {
+        close(fd);
+        return false;
+    }
+    size_t bytes = (size_t)info.st_size;
+    void* memoria = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memoria == MAP_FAILED) return false;
+
+    const CabeceraAnillo* c = static_cast<const CabeceraAnillo*>(memoria);
+    uint32_t magia = reinterpret_cast<const std::atomic<uint32_t>*>(&c->magia)->load(std::memory_order_acquire);
+    uint64_t capacidad = c->capacidad;
+    if (magia != PRT7_MAGIA_ANILLO || c->formato != PRT7_FORMATO_ANILLO || capacidad < 2 ||
+        (capacidad & (capacidad - 1)) != 0 || PRT7_INICIO_RANURAS + capacidad * sizeof(RanuraAnillo) != bytes) {
+        munmap(memoria, bytes);
+        return false;
+    }
+
+    cabecera = c;
+    ranuras = reinterpret_cast<const RanuraAnillo*>(static_cast<const char*>(memoria) + PRT7_INICIO_RANURAS);
+    mascara = capacidad - 1;
+    bytesMapeados = bytes;
+    perdidos = 0;
+
+    uint64_t publicados = cabecera->escritura.load(std::memory_order_acquire);
+    if (!desdeInicio) {
+        proximo = publicados;
+    } else {
+        // Lo anterior a la última vuelta ya fue pisado: cuenta como perdido
+        proximo = publicados > capacidad ? publicados - capacidad : 0;
+        perdidos = proximo;
+    }
+    return true;
+}
+
+bool LectorAnillo::siguiente(EventoAnillo& evento) {
+    if (!cabecera) return false;
+
+    while (true) {
+        uint64_t publicados = cabecera->escritura.load(std::memory_order_acquire);
+        if (proximo >= publicados) return false;
+        if (publicados - proximo > mascara + 1) {
+            // El publicador dio la vuelta: lo que no se leyó ya no existe
+            perdidos += publicados - (mascara + 1) - proximo;
+            proximo = publicados - (mascara + 1);
+        }
+
+        const RanuraAnillo& ranura = ranuras[proximo & mascara];
+        uint64_t antes = ranura.version.load(std::memory_order_acquire);
+        uint64_t datos = ranura.datos.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t despues = ranura.version.load(std::memory_order_relaxed);
+        if (antes != despues || antes != 2 * proximo + 2) {
+            // Pisada mientras se leía: la próxima vuelta la cuenta como perdida
+            continue;
+        }
+
+        evento.secuencia = proximo;
+        evento.tipo = (TipoEventoAnillo)(datos & 0xFF);
+        evento.rotor = (int)((datos >> 8) & 0xFF);
+        evento.crudo = (char)((datos >> 16) & 0xFF);
+        evento.decodificado = (char)((datos >> 24) & 0xFF);
+        evento.rotacion = (int)(int32_t)(uint32_t)(datos >> 32);
+        proximo++;
+        return true;
+    }
+}
+
+#endif
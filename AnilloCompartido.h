@@ -0,0 +1,219 @@
+/**
+ * @file AnilloCompartido.h
+ * @brief Anillo en memoria compartida para publicar la decodificación en vivo
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef ANILLO_COMPARTIDO_H
+#define ANILLO_COMPARTIDO_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum TipoEventoAnillo
+ * @brief Eventos que se publican en el anillo
+ */
+enum TipoEventoAnillo {
+    EVENTO_FRAGMENTO = 1, ///< Trama LOAD: fragmento recibido y decodificado
+    EVENTO_ROTACION = 2   ///< Trama MAP: rotación de un rotor
+};
+
+/**
+ * @struct EventoAnillo
+ * @brief Evento leído del anillo
+ */
+struct EventoAnillo {
+    uint64_t secuencia;   ///< Número de evento desde que se creó el anillo
+    TipoEventoAnillo tipo; ///< Tipo de evento
+    int rotor;            ///< Rotor afectado (EVENTO_ROTACION)
+    int rotacion;         ///< Posiciones rotadas (EVENTO_ROTACION)
+    char crudo;           ///< Carácter recibido (EVENTO_FRAGMENTO)
+    char decodificado;    ///< Carácter decodificado (EVENTO_FRAGMENTO)
+};
+
+/**
+ * @struct RanuraAnillo
+ * @brief Ranura de 16 bytes con su propio contador de secuencia (seqlock)
+ *
+ * Mientras el escritor la modifica el contador es impar; al terminar vale
+ * 2 * secuencia + 2. El lector copia los datos y comprueba que el contador
+ * no cambió: así sabe si el escritor la pisó sin que nadie tome candados.
+ */
+struct RanuraAnillo {
+    std::atomic<uint64_t> version; ///< 2 * secuencia + 2 cuando está completa
+    std::atomic<uint64_t> datos;   ///< Evento empaquetado
+};
+
+/**
+ * @struct CabeceraAnillo
+ * @brief Primeros bytes del objeto compartido; las ranuras van a continuación
+ */
+struct CabeceraAnillo {
+    uint32_t magia;                          ///< PRT7_MAGIA_ANILLO cuando está listo
+    uint32_t formato;                        ///< Versión del formato
+    uint64_t capacidad;                      ///< Ranuras (potencia de 2)
+    alignas(64) std::atomic<uint64_t> escritura; ///< Eventos publicados
+    std::atomic<uint32_t> cerrado;           ///< 1 cuando el publicador terminó
+};
+
+static const uint32_t PRT7_MAGIA_ANILLO = 0x37545250;  ///< "PRT7" en little-endian
+static const uint32_t PRT7_FORMATO_ANILLO = 1;          ///< Versión del formato
+static const size_t PRT7_INICIO_RANURAS = 128;          ///< Desplazamiento de la primera ranura
+
+/**
+ * @class PublicadorAnillo
+ * @brief Único escritor de un anillo en /dev/shm
+ *
+ * Publicar es escribir una ranura y avanzar un contador: nunca espera a los
+ * lectores. Si un lector se atrasa más de una vuelta, él mismo lo detecta
+ * por los números de secuencia y cuenta los eventos perdidos.
+ */
+class PublicadorAnillo {
+private:
+    CabeceraAnillo* cabecera; ///< Inicio del mapeo
+    RanuraAnillo* ranuras;    ///< Ranuras del anillo
+    uint64_t mascara;         ///< Capacidad - 1
+    uint64_t siguiente;       ///< Secuencia del próximo evento
+    size_t bytesMapeados;     ///< Tamaño del mapeo
+
+    /**
+     * @brief Escribe un evento empaquetado en su ranura y lo publica
+     * @param datos Evento empaquetado
+     */
+    void publicar(uint64_t datos) {
+        RanuraAnillo& ranura = ranuras[siguiente & mascara];
+        ranura.version.store(2 * siguiente + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        ranura.datos.store(datos, std::memory_order_relaxed);
+        ranura.version.store(2 * siguiente + 2, std::memory_order_release);
+        siguiente++;
+        cabecera->escritura.store(siguiente, std::memory_order_release);
+    }
+
+public:
+    /**
+     * @brief Constructor sin anillo; publicar sin crear() no está permitido
+     */
+    PublicadorAnillo();
+
+    /**
+     * @brief Destructor que marca el anillo como cerrado y lo desmapea
+     *
+     * El nombre sigue en /dev/shm hasta eliminar(), que el decodificador
+     * llama al terminar sin errores.
+     */
+    ~PublicadorAnillo();
+
+    PublicadorAnillo(const PublicadorAnillo&) = delete;
+    PublicadorAnillo& operator=(const PublicadorAnillo&) = delete;
+
+    /**
+     * @brief Crea el objeto compartido, reemplazando uno anterior con el mismo nombre
+     * @param nombre Nombre POSIX (ej. "/prt7"); queda en /dev/shm
+     * @param capacidadMinima Ranuras; se redondea a potencia de 2
+     * @return false si no se pudo crear o mapear
+     *
+     * Los lectores de un anillo anterior conservan su mapeo, que ve
+     * 'cerrado' y deja de crecer.
+     */
+    bool crear(const char* nombre, size_t capacidadMinima = 1 << 16);
+
+    /**
+     * @brief Borra el nombre de un anillo de /dev/shm
+     * @param nombre Nombre usado en crear()
+     * @return false si no existía
+     *
+     * Los procesos que lo tengan mapeado lo siguen viendo hasta desmapearlo.
+     */
+    static bool eliminar(const char* nombre);
+
+    /**
+     * @brief Publica un fragmento decodificado
+     * @param crudo Carácter recibido
+     * @param decodificado Carácter que se agregó al mensaje
+     */
+    void publicarFragmento(char crudo, char decodificado) {
+        publicar((uint64_t)EVENTO_FRAGMENTO | (uint64_t)(unsigned char)crudo << 16 |
+                 (uint64_t)(unsigned char)decodificado << 24);
+    }
+
+    /**
+     * @brief Publica la rotación de un rotor
+     * @param rotor Rotor rotado
+     * @param rotacion Posiciones rotadas
+     */
+    void publicarRotacion(int rotor, int rotacion) {
+        publicar((uint64_t)EVENTO_ROTACION | (uint64_t)(unsigned char)rotor << 8 |
+                 (uint64_t)(uint32_t)rotacion << 32);
+    }
+
+    /**
+     * @brief Eventos publicados
+     * @return Secuencia del próximo evento
+     */
+    uint64_t getPublicados() const { return siguiente; }
+};
+
+/**
+ * @class LectorAnillo
+ * @brief Lector de un anillo publicado por otro proceso
+ *
+ * Puede haber cualquier cantidad de lectores; ninguno escribe en el anillo
+ * y el mapeo es de sólo lectura, así que no afectan al publicador.
+ */
+class LectorAnillo {
+private:
+    const CabeceraAnillo* cabecera; ///< Inicio del mapeo
+    const RanuraAnillo* ranuras;    ///< Ranuras del anillo
+    uint64_t mascara;               ///< Capacidad - 1
+    uint64_t proximo;               ///< Secuencia del próximo evento a leer
+    uint64_t perdidos;              ///< Eventos pisados antes de leerlos
+    size_t bytesMapeados;           ///< Tamaño del mapeo
+
+public:
+    /**
+     * @brief Constructor sin anillo abierto
+     */
+    LectorAnillo();
+
+    /**
+     * @brief Destructor que desmapea el anillo
+     */
+    ~LectorAnillo();
+
+    LectorAnillo(const LectorAnillo&) = delete;
+    LectorAnillo& operator=(const LectorAnillo&) = delete;
+
+    /**
+     * @brief Abre un anillo existente
+     * @param nombre Nombre POSIX usado por el publicador
+     * @param desdeInicio true para empezar por el evento más antiguo retenido;
+     *        false para leer sólo lo que se publique de ahora en más
+     * @return false si no existe o no tiene el formato esperado
+     */
+    bool abrir(const char* nombre, bool desdeInicio = true);
+
+    /**
+     * @brief Lee el próximo evento si ya fue publicado
+     * @param evento Evento leído
+     * @return false si no hay eventos nuevos por ahora
+     */
+    bool siguiente(EventoAnillo& evento);
+
+    /**
+     * @brief Indica si el publicador cerró el anillo
+     * @return true si no se publicarán más eventos
+     */
+    bool cerrado() const { return cabecera && cabecera->cerrado.load(std::memory_order_acquire) != 0; }
+
+    /**
+     * @brief Eventos que el publicador pisó antes de que este lector los leyera
+     * @return Cantidad de eventos perdidos
+     */
+    uint64_t getPerdidos() const { return perdidos; }
+};
+
+#endif // ANILLO_COMPARTIDO_H
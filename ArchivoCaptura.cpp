@@ -0,0 +1,113 @@
+/**
+ * @file ArchivoCaptura.cpp
+ * @brief Implementación de la clase ArchivoCaptura
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "ArchivoCaptura.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#ifdef _WIN32
+ArchivoCaptura::ArchivoCaptura()
+    : datos(nullptr), tamano(0), hArchivo(INVALID_HANDLE_VALUE), hMapeo(NULL) {}
+#else
+ArchivoCaptura::ArchivoCaptura() : datos(nullptr), tamano(0), fd(-1) {}
+#endif
+
+ArchivoCaptura::~ArchivoCaptura() {
+    cerrar();
+}
+
+#ifdef _WIN32
+bool ArchivoCaptura::abrir(const char* ruta) {
+    cerrar();
+    
+    hArchivo = CreateFileA(ruta, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (hArchivo == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    LARGE_INTEGER tam;
+    if (!GetFileSizeEx(hArchivo, &tam)) {
+        cerrar();
+        return false;
+    }
+    if ((unsigned long long)tam.QuadPart > (size_t)-1) {
+        cerrar();
+        return false;
+    }
+    tamano = (size_t)tam.QuadPart;
+    if (tamano == 0) return true;
+    
+    hMapeo = CreateFileMappingA(hArchivo, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (hMapeo == NULL) {
+        cerrar();
+        return false;
+    }
+    
+    datos = static_cast<const char*>(MapViewOfFile(hMapeo, FILE_MAP_READ, 0, 0, 0));
+    if (!datos) {
+        cerrar();
+        return false;
+    }
+    return true;
+}
+
+void ArchivoCaptura::cerrar() {
+    if (datos) UnmapViewOfFile(datos);
+    if (hMapeo != NULL) CloseHandle(hMapeo);
+    if (hArchivo != INVALID_HANDLE_VALUE) CloseHandle(hArchivo);
+    datos = nullptr;
+    tamano = 0;
+    hMapeo = NULL;
+    hArchivo = INVALID_HANDLE_VALUE;
+}
+#else
+bool ArchivoCaptura::abrir(const char* ruta) {
+    cerrar();
+    
+    fd = open(ruta, O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        cerrar();
+        return false;
+    }
+    if ((unsigned long long)info.st_size > (size_t)-1) {
+        cerrar();
+        return false;
+    }
+    tamano = (size_t)info.st_size;
+    if (tamano == 0) return true;
+    
+    void* mapeo = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapeo == MAP_FAILED) {
+        cerrar();
+        return false;
+    }
+    
+    // Se recorre una sola vez de principio a fin
+    madvise(mapeo, tamano, MADV_SEQUENTIAL);
+    datos = static_cast<const char*>(mapeo);
+    return true;
+}
+
+void ArchivoCaptura::cerrar() {
+    if (datos) munmap(const_cast<char*>(datos), tamano);
+    if (fd != -1) close(fd);
+    datos = nullptr;
+    tamano = 0;
+    fd = -1;
+}
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @file ArchivoCaptura.h
+ * @brief Acceso a archivos de captura PRT-7 mapeados en memoria
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef ARCHIVO_CAPTURA_H
+#define ARCHIVO_CAPTURA_H
+
+#include <cstddef>
+
+#ifdef _WIN32
+    #include <windows.h>
+#endif
+
+/**
+ * @class ArchivoCaptura
+ * @brief Mapea un archivo de captura completo en memoria de sólo lectura
+ *
+ * Las tramas se parsean directamente sobre la memoria mapeada, sin copiar
+ * líneas a buffers intermedios. El sistema operativo trae las páginas del
+ * disco a medida que se recorren.
+ */
+class ArchivoCaptura {
+private:
+    const char* datos; ///< Inicio del archivo mapeado
+    size_t tamano;     ///< Tamaño del archivo en bytes (en Windows long es de 32 bits)
+#ifdef _WIN32
+    HANDLE hArchivo;   ///< Handle del archivo
+    HANDLE hMapeo;     ///< Handle del objeto de mapeo
+#else
+    int fd;            ///< Descriptor del archivo
+#endif
+
+public:
+    /**
+     * @brief Constructor que deja el objeto sin archivo abierto
+     */
+    ArchivoCaptura();
+
+    /**
+     * @brief Destructor que desmapea y cierra el archivo
+     */
+    ~ArchivoCaptura();
+
+    ArchivoCaptura(const ArchivoCaptura&) = delete;
+    ArchivoCaptura& operator=(const ArchivoCaptura&) = delete;
+
+    /**
+     * @brief Abre y mapea un archivo
+     * @param ruta Ruta del archivo de captura
+     * @return true si se pudo mapear (un archivo vacío también es válido);
+     *         false también si no cabe en el espacio de direcciones
+     */
+    bool abrir(const char* ruta);
+
+    /**
+     * @brief Desmapea y cierra el archivo actual
+     */
+    void cerrar();
+
+    /**
+     * @brief Obtiene el contenido mapeado
+     * @return Puntero al primer byte (nullptr si está vacío)
+     */
+    const char* getDatos() const { return datos; }
+
+    /**
+     * @brief Obtiene el tamaño del archivo
+     * @return Bytes mapeados
+     */
+    size_t getTamano() const { return tamano; }
+};
+
+#endif // ARCHIVO_CAPTURA_H
@@ -0,0 +1,74 @@
+/**
+ * @file BusquedaIncremental.cpp
+ * @brief Implementación de la clase BusquedaIncremental
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "BusquedaIncremental.h"
+#include <cstring>
+
+void construirTablaFallos(const char* patron, long longitud, long* fallo) {
+    fallo[0] = 0;
+    for (long i = 1, k = 0; i < longitud; i++) {
+        while (k > 0 && patron[i] != patron[k]) k = fallo[k - 1];
+        if (patron[i] == patron[k]) k++;
+        fallo[i] = k;
+    }
+}
+
+BusquedaIncremental::BusquedaIncremental(const char* texto)
+    : emparejados(0), revisados(0), ultimo(nullptr), coincidencias(0), omitidos(0) {
+    longitudPatron = (long)strlen(texto);
+    patron = new char[longitudPatron + 1];
+    memcpy(patron, texto, longitudPatron + 1);
+
+    fallo = new long[longitudPatron > 0 ? longitudPatron : 1];
+    fallo[0] = 0;
+    if (longitudPatron > 0) construirTablaFallos(patron, longitudPatron, fallo);
+}
+
+BusquedaIncremental::~BusquedaIncremental() {
+    delete[] patron;
+    delete[] fallo;
+}
+
+bool BusquedaIncremental::siguiente(const ListaDeCarga& carga, long& posicion) {
+    if (longitudPatron == 0) return false;
+
+    if (revisados < carga.getEmitidos()) {
+        // La lista ya soltó esos caracteres: se retoma en su cabeza
+        omitidos += carga.getEmitidos() - revisados;
+        revisados = carga.getEmitidos();
+        emparejados = 0;
+        ultimo = nullptr;
+    }
+
+    // El último nodo revisado sigue en la lista mientras no se haya emitido
+    const NodoCarga* nodo;
+    if (ultimo && revisados - 1 >= carga.getEmitidos()) {
+        nodo = ultimo->siguiente;
+    } else {
+        nodo = carga.localizar(revisados);
+    }
+
+    while (nodo) {
+        char dato = nodo->dato;
+        while (emparejados > 0 && dato != patron[emparejados]) {
+            emparejados = fallo[emparejados - 1];
+        }
+        if (dato == patron[emparejados]) emparejados++;
+
+        ultimo = nodo;
+        revisados++;
+        nodo = nodo->siguiente;
+
+        if (emparejados == longitudPatron) {
+            emparejados = fallo[longitudPatron - 1];
+            coincidencias++;
+            posicion = revisados - longitudPatron;
+            return true;
+        }
+    }
+    return false;
+}
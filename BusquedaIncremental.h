@@ -0,0 +1,90 @@
+/**
+ * @file BusquedaIncremental.h
+ * @brief Búsqueda de un texto en la lista de carga a medida que crece
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef BUSQUEDA_INCREMENTAL_H
+#define BUSQUEDA_INCREMENTAL_H
+
+#include "ListaDeCarga.h"
+
+/**
+ * @brief Construye la tabla de fallos de Knuth-Morris-Pratt
+ * @param patron Texto buscado
+ * @param longitud Bytes del texto, mayor que cero
+ * @param fallo Arreglo de 'longitud' elementos; fallo[i] queda con el largo
+ *        del mayor borde propio de patron[0..i]
+ *
+ * La usan BusquedaIncremental y ListaDeCarga::buscar().
+ */
+void construirTablaFallos(const char* patron, long longitud, long* fallo);
+
+/**
+ * @class BusquedaIncremental
+ * @brief Busca un texto en la lista de carga revisando sólo lo nuevo
+ *
+ * Guarda el estado del autómata de Knuth-Morris-Pratt y el último nodo
+ * revisado, así que cada llamada a siguiente() continúa donde quedó la
+ * anterior aunque la coincidencia cruce tramas: buscar mientras se
+ * decodifica cuesta O(1) amortizado por fragmento y nunca copia el mensaje.
+ * Si en modo flujo la lista emite caracteres antes de revisarlos, la
+ * búsqueda salta al primer carácter retenido y los cuenta como omitidos.
+ */
+class BusquedaIncremental {
+private:
+    char* patron;            ///< Texto buscado
+    long longitudPatron;     ///< Bytes del texto buscado
+    long* fallo;             ///< Tabla de fallos de KMP
+    long emparejados;        ///< Prefijo del patrón reconocido al final de lo revisado
+    long revisados;          ///< Posición del siguiente carácter a revisar
+    const NodoCarga* ultimo; ///< Nodo en la posición revisados - 1, o nullptr
+    long coincidencias;      ///< Coincidencias encontradas
+    long omitidos;           ///< Caracteres emitidos por la lista antes de revisarlos
+
+public:
+    /**
+     * @brief Constructor que prepara la tabla de fallos
+     * @param texto Texto a buscar, terminado en '\\0'
+     */
+    explicit BusquedaIncremental(const char* texto);
+
+    /**
+     * @brief Destructor que libera el patrón y su tabla
+     */
+    ~BusquedaIncremental();
+
+    BusquedaIncremental(const BusquedaIncremental&) = delete;
+    BusquedaIncremental& operator=(const BusquedaIncremental&) = delete;
+
+    /**
+     * @brief Avanza sobre lo agregado a la lista hasta la próxima coincidencia
+     * @param carga Lista en la que se busca (siempre la misma)
+     * @param posicion Posición en el mensaje donde empieza la coincidencia
+     * @return false si se revisó todo lo que hay sin encontrar otra
+     *
+     * Las coincidencias solapadas se informan todas.
+     */
+    bool siguiente(const ListaDeCarga& carga, long& posicion);
+
+    /**
+     * @brief Obtiene el texto buscado
+     * @return Patrón terminado en '\\0'
+     */
+    const char* getPatron() const { return patron; }
+
+    /**
+     * @brief Coincidencias informadas por siguiente()
+     * @return Cantidad de coincidencias
+     */
+    long getCoincidencias() const { return coincidencias; }
+
+    /**
+     * @brief Caracteres que no se alcanzaron a revisar en modo flujo
+     * @return Cantidad de caracteres omitidos
+     */
+    long getOmitidos() const { return omitidos; }
+};
+
+#endif // BUSQUEDA_INCREMENTAL_H
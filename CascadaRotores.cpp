@@ -0,0 +1,52 @@
+/**
+ * @file CascadaRotores.cpp
+ * @brief Implementación de la clase CascadaRotores
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "CascadaRotores.h"
+
+CascadaRotores::CascadaRotores(int n) {
+    if (n < 1) n = 1;
+    if (n > MAX_ROTORES) n = MAX_ROTORES;
+    numRotores = n;
+    rotores = new RotorDeMapeo[numRotores];
+
+    // Los bytes fuera de A-Z nunca cambian: se fijan una sola vez
+    for (int c = 0; c < 256; c++) {
+        tabla[c] = (char)c;
+        inversa[c] = (char)c;
+    }
+    recomponer();
+}
+
+CascadaRotores::~CascadaRotores() {
+    delete[] rotores;
+}
+
+void CascadaRotores::recomponer() {
+    const int T = RotorDeMapeo::TAMANO_ALFABETO;
+
+    // Sin recorrer los rotores letra por letra: la cadena avanza cada letra
+    // la suma de los desplazamientos
+    int suma = 0;
+    for (int i = 0; i < numRotores; i++) {
+        suma = (suma + rotores[i].getDesplazamiento()) % T;
+    }
+
+    for (int p = 0; p < T; p++) {
+        char salida = (char)('A' + (p + suma) % T);
+        tabla['A' + p] = salida;
+        inversa[(unsigned char)salida] = (char)('A' + p);
+    }
+}
+
+bool CascadaRotores::rotar(int indice, int N) {
+    if (indice < 0 || indice >= numRotores) return false;
+    if (N % RotorDeMapeo::TAMANO_ALFABETO == 0) return true;
+
+    rotores[indice].rotar(N);
+    recomponer();
+    return true;
+}
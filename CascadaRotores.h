@@ -0,0 +1,92 @@
+/**
+ * @file CascadaRotores.h
+ * @brief Cadena de rotores con la sustitución compuesta precalculada
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef CASCADA_ROTORES_H
+#define CASCADA_ROTORES_H
+
+#include "RotorDeMapeo.h"
+
+/**
+ * @class CascadaRotores
+ * @brief Encadena N rotores y decodifica con una sola consulta a tabla
+ *
+ * Cada fragmento pasa por el rotor 0, luego por el 1 y así hasta el último.
+ * Como cada rotor es una rotación de A-Z, la composición es la rotación por
+ * la suma de los desplazamientos; se guarda como una tabla de 256 bytes que
+ * sólo se recalcula cuando una trama MAP mueve un rotor. getMapeo() cuesta
+ * lo mismo con 1 o con 32 rotores.
+ */
+class CascadaRotores {
+public:
+    static const int MAX_ROTORES = 32; ///< Límite del selector de rotor del formato binario
+
+private:
+    RotorDeMapeo* rotores;  ///< Rotores de la cadena, en orden de aplicación
+    int numRotores;         ///< Cantidad de rotores
+    char tabla[256];        ///< Sustitución compuesta de toda la cadena
+    char inversa[256];      ///< Byte de entrada que produce cada byte de salida
+
+    /**
+     * @brief Recalcula la tabla compuesta y su inversa en O(N + 26)
+     *
+     * Sólo cambian las 26 letras: el espacio y los demás bytes pasan sin
+     * cambios por todos los rotores.
+     */
+    void recomponer();
+
+public:
+    /**
+     * @brief Constructor con todos los rotores en su posición inicial
+     * @param n Cantidad de rotores, entre 1 y MAX_ROTORES
+     */
+    explicit CascadaRotores(int n = 1);
+
+    /**
+     * @brief Destructor que libera los rotores
+     */
+    ~CascadaRotores();
+
+    CascadaRotores(const CascadaRotores&) = delete;
+    CascadaRotores& operator=(const CascadaRotores&) = delete;
+
+    /**
+     * @brief Rota un rotor de la cadena y recalcula la tabla compuesta
+     * @param indice Rotor a mover (0 es el primero que recibe el fragmento)
+     * @param N Posiciones a rotar (positivo o negativo)
+     * @return false si el índice no pertenece a la cadena; no se rota nada
+     */
+    bool rotar(int indice, int N);
+
+    /**
+     * @brief Decodifica un fragmento con toda la cadena en O(1)
+     * @param in Carácter recibido en una trama LOAD
+     * @return Carácter tras pasar por todos los rotores
+     */
+    char getMapeo(char in) const { return tabla[(unsigned char)in]; }
+
+    /**
+     * @brief Inverso de getMapeo() para las posiciones actuales
+     * @param salida Carácter que se desea obtener
+     * @return Carácter a enviar en una trama LOAD
+     */
+    char getInverso(char salida) const { return inversa[(unsigned char)salida]; }
+
+    /**
+     * @brief Obtiene la cantidad de rotores
+     * @return Rotores de la cadena
+     */
+    int getNumRotores() const { return numRotores; }
+
+    /**
+     * @brief Acceso de sólo lectura a un rotor
+     * @param indice Posición en la cadena, en [0, getNumRotores())
+     * @return Rotor solicitado
+     */
+    const RotorDeMapeo& getRotor(int indice) const { return rotores[indice]; }
+};
+
+#endif // CASCADA_ROTORES_H
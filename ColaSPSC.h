@@ -0,0 +1,132 @@
+/**
+ * @file ColaSPSC.h
+ * @brief Cola circular sin candados para un productor y un consumidor
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef COLA_SPSC_H
+#define COLA_SPSC_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class ColaSPSC
+ * @brief Anillo de capacidad fija con índices atómicos
+ *
+ * Sólo un hilo puede insertar y sólo un hilo puede extraer. Cada índice lo
+ * escribe un único hilo, así que basta con orden adquirir/liberar: el
+ * productor publica el elemento al avanzar 'escritura' y el consumidor
+ * libera la ranura al avanzar 'lectura'. Los índices van en líneas de
+ * caché separadas para que ambos hilos no se estorben.
+ *
+ * @tparam T Tipo de elemento (copiable)
+ */
+template <typename T>
+class ColaSPSC {
+private:
+    T* elementos;                              ///< Ranuras del anillo
+    size_t mascara;                            ///< Capacidad - 1 (potencia de 2)
+    alignas(64) std::atomic<size_t> escritura; ///< Próxima ranura a escribir (productor)
+    alignas(64) std::atomic<size_t> lectura;   ///< Próxima ranura a leer (consumidor)
+    alignas(64) std::atomic<size_t> maximo;    ///< Mayor profundidad observada
+    std::atomic<bool> cerrada;                 ///< El productor ya no insertará más
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacidadMinima Capacidad deseada; se redondea a potencia de 2
+     */
+    explicit ColaSPSC(size_t capacidadMinima) : escritura(0), lectura(0), maximo(0), cerrada(false) {
+        size_t capacidad = 2;
+        while (capacidad < capacidadMinima) capacidad *= 2;
+        elementos = new T[capacidad];
+        mascara = capacidad - 1;
+    }
+
+    /**
+     * @brief Destructor que libera las ranuras
+     */
+    ~ColaSPSC() {
+        delete[] elementos;
+    }
+
+    ColaSPSC(const ColaSPSC&) = delete;
+    ColaSPSC& operator=(const ColaSPSC&) = delete;
+
+    /**
+     * @brief Inserta un elemento si hay espacio (sólo productor)
+     * @param elemento Elemento a copiar en la cola
+     * @return false si la cola está llena
+     */
+    bool intentarInsertar(const T& elemento) {
+        size_t e = escritura.load(std::memory_order_relaxed);
+        size_t l = lectura.load(std::memory_order_acquire);
+        if (e - l > mascara) return false;
+
+        elementos[e & mascara] = elemento;
+        escritura.store(e + 1, std::memory_order_release);
+
+        size_t profundidad = e + 1 - l;
+        if (profundidad > maximo.load(std::memory_order_relaxed)) {
+            maximo.store(profundidad, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Extrae un elemento si hay alguno (sólo consumidor)
+     * @param elemento Destino del elemento extraído
+     * @return false si la cola está vacía
+     */
+    bool intentarExtraer(T& elemento) {
+        size_t l = lectura.load(std::memory_order_relaxed);
+        size_t e = escritura.load(std::memory_order_acquire);
+        if (l == e) return false;
+
+        elemento = elementos[l & mascara];
+        lectura.store(l + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Indica que el productor terminó (sólo productor)
+     */
+    void cerrar() {
+        cerrada.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Indica si la cola está cerrada y ya no tiene elementos
+     * @return true si el consumidor puede terminar
+     */
+    bool agotada() const {
+        if (!cerrada.load(std::memory_order_acquire)) return false;
+        return lectura.load(std::memory_order_acquire) == escritura.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Profundidad actual aproximada (segura desde cualquier hilo)
+     * @return Elementos en la cola
+     */
+    size_t profundidad() const {
+        size_t l = lectura.load(std::memory_order_acquire);
+        size_t e = escritura.load(std::memory_order_acquire);
+        return e - l;
+    }
+
+    /**
+     * @brief Mayor profundidad observada por el productor
+     * @return Máximo de elementos encolados a la vez
+     */
+    size_t profundidadMaxima() const { return maximo.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Capacidad real de la cola
+     * @return Cantidad de ranuras
+     */
+    size_t capacidad() const { return mascara + 1; }
+};
+
+#endif // COLA_SPSC_H
@@ -0,0 +1,60 @@
+/**
+ * @file ContextoDecodificacion.cpp
+ * @brief Implementación de la clase ContextoDecodificacion
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "ContextoDecodificacion.h"
+#include "ParserTramas.h"
+
+ContextoDecodificacion::ContextoDecodificacion(int numRotores, bool conservar, AlfabetoTramas elegido)
+    : alfabeto(elegido),
+      cascada(numRotores > 1 && elegido == ALFABETO_MAYUSCULAS ? new CascadaRotores(numRotores) : nullptr),
+      drenados(0), conservarMensaje(conservar), tramas(0) {
+    // La cadena de rotores sólo existe para A-Z: con el alfabeto imprimible
+    // los MAP a otros rotores se cuentan como mal formados
+    lector.configurarRotores(cascada ? cascada->getNumRotores() : 1);
+    // Sin progreso: el contexto nunca escribe en la consola
+    carga.configurarProgreso(PROGRESO_APAGADO);
+}
+
+ContextoDecodificacion::~ContextoDecodificacion() {
+    delete cascada;
+}
+
+long ContextoDecodificacion::aplicarTramas() {
+    long aplicadas = 0;
+    TramaValor trama;
+    while (lector.siguiente(trama)) {
+        if (cascada) {
+            despacharTramaCascada(trama, &carga, cascada);
+        } else if (alfabeto == ALFABETO_IMPRIMIBLE) {
+            despacharTrama(trama, &carga, &rotorImprimible);
+        } else {
+            despacharTrama(trama, &carga, &rotor);
+        }
+        aplicadas++;
+    }
+    tramas += aplicadas;
+    return aplicadas;
+}
+
+long ContextoDecodificacion::empujar(const char* datos, long n) {
+    long aplicadas = 0;
+    long usados = 0;
+    while (usados < n) {
+        // El lector acepta hasta llenar su buffer; extraer tramas libera
+        // espacio (una línea que no cabe se descarta como mal formada)
+        usados += lector.empujar(datos + usados, n - usados);
+        aplicadas += aplicarTramas();
+    }
+    return aplicadas;
+}
+
+long ContextoDecodificacion::drenar(char* destino, long capacidad) {
+    long copiados = carga.extraer(drenados, capacidad, destino);
+    drenados += copiados;
+    if (!conservarMensaje) carga.descartarAntiguos(copiados);
+    return copiados;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file ContextoDecodificacion.h
+ * @brief Decodificador PRT-7 embebible: bytes crudos de entrada, mensaje de salida
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef CONTEXTO_DECODIFICACION_H
+#define CONTEXTO_DECODIFICACION_H
+
+#include "LectorTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "RotorAlfabeto.h"
+#include "CascadaRotores.h"
+
+/**
+ * @class ContextoDecodificacion
+ * @brief Todo el estado de un flujo PRT-7 en un objeto, sin E/S ni variables globales
+ *
+ * Para integrar el decodificador en otro programa (biblioteca prt7): los
+ * bytes llegan con empujar() tal como salen del puerto o de un socket, en
+ * trozos de cualquier tamaño, y el mensaje decodificado se retira con
+ * drenar(). El formato (texto o binario) se detecta igual que en el puerto.
+ *
+ * Cada contexto es independiente: un proceso puede decodificar varios
+ * flujos, cada uno desde su propio hilo. Un mismo contexto no debe usarse
+ * desde dos hilos a la vez.
+ */
+class ContextoDecodificacion {
+private:
+    LectorTramas lector;      ///< Armado de tramas y detección de formato
+    RotorDeMapeo rotor;       ///< Rotor con un solo rotor
+    RotorImprimible rotorImprimible; ///< Rotor con ALFABETO_IMPRIMIBLE
+    AlfabetoTramas alfabeto;  ///< Alfabeto con que se decodifican las tramas LOAD
+    CascadaRotores* cascada;  ///< Cadena de rotores, o nullptr con uno solo
+    ListaDeCarga carga;       ///< Fragmentos decodificados aún no descartados
+    long drenados;            ///< Posición en el mensaje del próximo carácter a drenar
+    bool conservarMensaje;    ///< Mantener lo drenado en getCarga()
+    long tramas;              ///< Tramas válidas aplicadas
+
+    /**
+     * @brief Aplica al rotor y a la lista las tramas completas recibidas
+     * @return Tramas aplicadas
+     */
+    long aplicarTramas();
+
+public:
+    /**
+     * @brief Constructor
+     * @param numRotores Rotores de la cadena ("M,R,N"), entre 1 y CascadaRotores::MAX_ROTORES
+     * @param conservar true para mantener todo el mensaje en getCarga() (para
+     *        buscar() o caracterEn()); false para liberar lo drenado
+     * @param alfabeto ALFABETO_IMPRIMIBLE para firmware que envía minúsculas
+     *        y dígitos; usa un solo rotor, así que numRotores debe ser 1
+     */
+    explicit ContextoDecodificacion(int numRotores = 1, bool conservar = false,
+                                    AlfabetoTramas alfabeto = ALFABETO_MAYUSCULAS);
+
+    /**
+     * @brief Destructor
+     */
+    ~ContextoDecodificacion();
+
+    ContextoDecodificacion(const ContextoDecodificacion&) = delete;
+    ContextoDecodificacion& operator=(const ContextoDecodificacion&) = delete;
+
+    /**
+     * @brief Entrega bytes crudos del flujo y aplica las tramas que completen
+     * @param datos Bytes recibidos
+     * @param n Cantidad de bytes
+     * @return Tramas aplicadas con estos bytes
+     *
+     * Una trama partida entre dos llamadas se completa en la siguiente.
+     */
+    long empujar(const char* datos, long n);
+
+    /**
+     * @brief Retira el mensaje decodificado desde la última llamada
+     * @param destino Buffer de salida
+     * @param capacidad Bytes disponibles en destino
+     * @return Bytes copiados; 0 si no hay nada pendiente
+     */
+    long drenar(char* destino, long capacidad);
+
+    /**
+     * @brief Caracteres decodificados que todavía no se drenaron
+     * @return Bytes que entregaría drenar() con capacidad suficiente
+     */
+    long getPendientes() const { return carga.getEmitidos() + carga.getLongitud() - drenados; }
+
+    /**
+     * @brief Tramas válidas aplicadas desde la creación
+     * @return Cantidad de tramas
+     */
+    long getTramas() const { return tramas; }
+
+    /**
+     * @brief Tramas descartadas por estar mal formadas
+     * @return Cantidad de tramas descartadas
+     */
+    long getMalformadas() const { return lector.getMalformadas(); }
+
+    /**
+     * @brief Alfabeto con que se decodifican las tramas LOAD
+     * @return Alfabeto elegido en el constructor
+     */
+    AlfabetoTramas getAlfabeto() const { return alfabeto; }
+
+    /**
+     * @brief Formato detectado en el flujo
+     * @return Protocolo, o PROTOCOLO_DESCONOCIDO si aún no llegó una trama completa
+     */
+    ProtocoloPRT7 getProtocolo() const { return lector.getProtocolo(); }
+
+    /**
+     * @brief Mensaje decodificado que se conserva en memoria
+     * @return Lista de carga; sin conservar sólo contiene lo no drenado
+     */
+    const ListaDeCarga& getCarga() const { return carga; }
+};
+
+#endif // CONTEXTO_DECODIFICACION_H
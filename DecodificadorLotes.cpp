@@ -0,0 +1,152 @@
+/**
+ * @file DecodificadorLotes.cpp
+ * @brief Implementación de la clase DecodificadorLotes
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "DecodificadorLotes.h"
+#include "NucleoDecodificacion.h"
+#include <thread>
+
+/**
+ * @brief Suma las rotaciones MAP de un tramo módulo el tamaño del alfabeto
+ * @param tramas Inicio del tramo
+ * @param n Cantidad de tramas del tramo
+ * @return Rotación neta en [0, TAMANO_ALFABETO)
+ */
+static int sumarRotaciones(const TramaValor* tramas, long n) {
+    const int T = RotorDeMapeo::TAMANO_ALFABETO;
+    int suma = 0;
+    for (long i = 0; i < n; i++) {
+        if (tramas[i].tipo == TRAMA_MAP && tramas[i].rotor == 0) {
+            suma = (suma + tramas[i].rotacion % T + T) % T;
+        }
+    }
+    return suma;
+}
+
+/**
+ * @brief Decodifica un tramo de forma secuencial
+ * @param tramas Inicio del tramo
+ * @param n Cantidad de tramas del tramo
+ * @param desplazamientoInicial Posición del rotor al comenzar el tramo
+ * @param segmento Lista donde se insertan los caracteres decodificados
+ *
+ * Las rachas de tramas LOAD entre dos MAP se acumulan en un buffer y se
+ * decodifican juntas con el núcleo vectorizado.
+ */
+static void decodificarTramo(const TramaValor* tramas, long n, int desplazamientoInicial,
+                             ListaDeCarga* segmento) {
+    const int T = RotorDeMapeo::TAMANO_ALFABETO;
+    const int TAMANO_RACHA = 1024;
+    char racha[TAMANO_RACHA];
+    int enRacha = 0;
+    int desplazamiento = desplazamientoInicial;
+
+    for (long i = 0; i < n; i++) {
+        if (tramas[i].tipo == TRAMA_LOAD) {
+            racha[enRacha++] = tramas[i].caracter;
+            if (enRacha == TAMANO_RACHA) {
+                decodificarBloque(racha, racha, enRacha, desplazamiento);
+                segmento->insertarBloque(racha, enRacha);
+                enRacha = 0;
+            }
+        } else if (tramas[i].tipo == TRAMA_MAP && tramas[i].rotor == 0) {
+            if (enRacha > 0) {
+                decodificarBloque(racha, racha, enRacha, desplazamiento);
+                segmento->insertarBloque(racha, enRacha);
+                enRacha = 0;
+            }
+            desplazamiento = (desplazamiento + tramas[i].rotacion % T + T) % T;
+        }
+    }
+
+    if (enRacha > 0) {
+        decodificarBloque(racha, racha, enRacha, desplazamiento);
+        segmento->insertarBloque(racha, enRacha);
+    }
+}
+
+DecodificadorLotes::DecodificadorLotes(int hilos) : numHilos(hilos) {
+    if (numHilos <= 0) {
+        numHilos = (int)std::thread::hardware_concurrency();
+        if (numHilos <= 0) numHilos = 1;
+    }
+}
+
+int DecodificadorLotes::calcularSegmentos(long n) const {
+    long segmentos = n / TRAMAS_MINIMAS_POR_HILO;
+    if (segmentos > numHilos) segmentos = numHilos;
+    if (segmentos < 1) segmentos = 1;
+    return (int)segmentos;
+}
+
+int DecodificadorLotes::decodificarSegmentos(const TramaValor* tramas, long n, RotorDeMapeo* rotor,
+                                             ListaDeCarga* segmentos) {
+    const int T = RotorDeMapeo::TAMANO_ALFABETO;
+    int k = calcularSegmentos(n);
+
+    long* inicio = new long[k + 1];
+    int* suma = new int[k];
+    for (int t = 0; t <= k; t++) {
+        inicio[t] = n * t / k;
+    }
+
+    std::thread* hilos = new std::thread[k];
+
+    // Fase 1: rotación neta de cada tramo
+    for (int t = 1; t < k; t++) {
+        hilos[t] = std::thread([=]() {
+            suma[t] = sumarRotaciones(tramas + inicio[t], inicio[t + 1] - inicio[t]);
+        });
+    }
+    suma[0] = sumarRotaciones(tramas, inicio[1]);
+    for (int t = 1; t < k; t++) {
+        hilos[t].join();
+    }
+
+    // Suma prefija exclusiva: desplazamiento del rotor al entrar a cada tramo
+    int* desplazamiento = new int[k];
+    int acumulado = rotor->getDesplazamiento();
+    for (int t = 0; t < k; t++) {
+        desplazamiento[t] = acumulado;
+        acumulado = (acumulado + suma[t]) % T;
+    }
+
+    // Fase 2: cada tramo se decodifica en su propio segmento
+    for (int t = 1; t < k; t++) {
+        hilos[t] = std::thread([=]() {
+            decodificarTramo(tramas + inicio[t], inicio[t + 1] - inicio[t],
+                             desplazamiento[t], &segmentos[t]);
+        });
+    }
+    decodificarTramo(tramas, inicio[1], desplazamiento[0], &segmentos[0]);
+    for (int t = 1; t < k; t++) {
+        hilos[t].join();
+    }
+
+    rotor->rotar(acumulado - rotor->getDesplazamiento());
+
+    delete[] hilos;
+    delete[] desplazamiento;
+    delete[] suma;
+    delete[] inicio;
+    return k;
+}
+
+void DecodificadorLotes::decodificar(const TramaValor* tramas, long n, ListaDeCarga* carga,
+                                     RotorDeMapeo* rotor) {
+    int k = calcularSegmentos(n);
+    ListaDeCarga* segmentos = new ListaDeCarga[k];
+    for (int t = 0; t < k; t++) {
+        segmentos[t].configurarProgreso(PROGRESO_APAGADO);
+    }
+
+    k = decodificarSegmentos(tramas, n, rotor, segmentos);
+    for (int t = 0; t < k; t++) {
+        carga->concatenar(segmentos[t]);
+    }
+
+    delete[] segmentos;
+}
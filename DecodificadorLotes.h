@@ -0,0 +1,76 @@
+/**
+ * @file DecodificadorLotes.h
+ * @brief Decodificación paralela de lotes de tramas mediante suma prefija de rotaciones
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef DECODIFICADOR_LOTES_H
+#define DECODIFICADOR_LOTES_H
+
+#include "TramaValor.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+/**
+ * @class DecodificadorLotes
+ * @brief Decodifica un buffer de tramas usando todos los núcleos disponibles
+ *
+ * El estado del rotor al llegar a una trama LOAD es sólo la suma de las
+ * rotaciones MAP anteriores módulo 26. El lote se divide en tramos: primero
+ * cada hilo suma las rotaciones de su tramo, luego se calcula la suma prefija
+ * de esos totales y por último cada hilo decodifica su tramo en su propio
+ * segmento de ListaDeCarga partiendo del desplazamiento que le corresponde.
+ */
+class DecodificadorLotes {
+private:
+    int numHilos; ///< Máximo de hilos a utilizar
+
+public:
+    /**
+     * @brief Tramas mínimas por tramo para que valga la pena crear un hilo
+     */
+    static const long TRAMAS_MINIMAS_POR_HILO = 4096;
+
+    /**
+     * @brief Constructor
+     * @param hilos Número de hilos (0 = núcleos disponibles)
+     */
+    DecodificadorLotes(int hilos = 0);
+
+    /**
+     * @brief Obtiene el número máximo de hilos
+     * @return Hilos configurados
+     */
+    int getNumHilos() const { return numHilos; }
+
+    /**
+     * @brief Calcula cuántos segmentos se usarán para un lote
+     * @param n Cantidad de tramas del lote
+     * @return Número de segmentos (al menos 1)
+     */
+    int calcularSegmentos(long n) const;
+
+    /**
+     * @brief Decodifica un lote dejando el resultado en segmentos separados
+     * @param tramas Buffer de tramas
+     * @param n Cantidad de tramas
+     * @param rotor Rotor con el estado inicial; al terminar queda rotado como
+     *              si se hubieran procesado todas las tramas MAP del lote
+     * @param segmentos Arreglo de al menos calcularSegmentos(n) listas vacías
+     * @return Número de segmentos utilizados, en orden de flujo
+     */
+    int decodificarSegmentos(const TramaValor* tramas, long n, RotorDeMapeo* rotor,
+                             ListaDeCarga* segmentos);
+
+    /**
+     * @brief Decodifica un lote y agrega el resultado al final de la lista
+     * @param tramas Buffer de tramas
+     * @param n Cantidad de tramas
+     * @param carga Lista donde se concatenan los segmentos
+     * @param rotor Rotor con el estado inicial; queda actualizado
+     */
+    void decodificar(const TramaValor* tramas, long n, ListaDeCarga* carga, RotorDeMapeo* rotor);
+};
+
+#endif // DECODIFICADOR_LOTES_H
@@ -0,0 +1,75 @@
+/**
+ * @file EnsambladorLineas.cpp
+ * @brief Implementación de la clase EnsambladorLineas
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "EnsambladorLineas.h"
+#include "Instrumentacion.h"
+#include <cstring>
+
+EnsambladorLineas::EnsambladorLineas() : inicio(0), fin(0), descartadas(0), descartando(false) {}
+
+char* EnsambladorLineas::espacioLibre(int& disponible) {
+    if (fin == CAPACIDAD) {
+        if (inicio > 0) {
+            // Mover la línea incompleta al principio del buffer
+            memmove(buffer, buffer + inicio, fin - inicio);
+            fin -= inicio;
+            inicio = 0;
+        } else {
+            // Una línea sin fin que llena el buffer no puede ser una trama
+            descartadas++;
+            PRT7_CONTAR(CONTADOR_MALFORMADAS, 1);
+            inicio = fin = 0;
+            descartando = true;
+        }
+    }
+
+    disponible = CAPACIDAD - fin;
+    return buffer + fin;
+}
+
+void EnsambladorLineas::confirmar(int n) {
+    if (descartando) {
+        // El buffer quedó vacío al descartar: los bytes nuevos empiezan en 0
+        const char* salto = static_cast<const char*>(memchr(buffer + fin, '\n', n));
+        if (!salto) return;
+        descartando = false;
+        inicio = (int)(salto - buffer) + 1;
+    }
+    fin += n;
+}
+
+bool EnsambladorLineas::siguienteLinea(const char*& linea, long& longitud) {
+    while (inicio < fin) {
+        const char* salto = static_cast<const char*>(memchr(buffer + inicio, '\n', fin - inicio));
+        if (!salto) break;
+
+        int posSalto = (int)(salto - buffer);
+        linea = buffer + inicio;
+        longitud = posSalto - inicio;
+        if (longitud > 0 && linea[longitud - 1] == '\r') longitud--;
+
+        inicio = posSalto + 1;
+        if (longitud > 0) return true;
+    }
+
+    if (inicio == fin) {
+        inicio = fin = 0;
+    }
+    return false;
+}
+
+const char* EnsambladorLineas::pendientes(int& n) const {
+    n = fin - inicio;
+    return buffer + inicio;
+}
+
+void EnsambladorLineas::consumir(int n) {
+    inicio += n;
+    if (inicio >= fin) {
+        inicio = fin = 0;
+    }
+}
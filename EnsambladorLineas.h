@@ -0,0 +1,86 @@
+/**
+ * @file EnsambladorLineas.h
+ * @brief Buffer de recepción que arma líneas completas a partir de lecturas parciales
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef ENSAMBLADOR_LINEAS_H
+#define ENSAMBLADOR_LINEAS_H
+
+/**
+ * @class EnsambladorLineas
+ * @brief Acumula bytes recibidos y entrega las líneas completas sin copiarlas
+ *
+ * Cada fuente de datos tiene su propio ensamblador, por lo que no hay
+ * estado compartido entre puertos. Las líneas se devuelven como punteros
+ * dentro del buffer interno y son válidas hasta la siguiente escritura.
+ */
+class EnsambladorLineas {
+public:
+    static const int CAPACIDAD = 4096; ///< Bytes del buffer interno
+
+private:
+    char buffer[CAPACIDAD]; ///< Bytes recibidos
+    int inicio;             ///< Primer byte aún no entregado
+    int fin;                ///< Fin de los bytes válidos
+    long descartadas;       ///< Líneas descartadas por exceder el buffer
+    bool descartando;       ///< Saltando el resto de una línea descartada hasta su '\n'
+
+public:
+    /**
+     * @brief Constructor que deja el buffer vacío
+     */
+    EnsambladorLineas();
+
+    /**
+     * @brief Obtiene espacio libre para escribir bytes recibidos
+     * @param disponible Cantidad de bytes que se pueden escribir
+     * @return Puntero donde escribir
+     *
+     * Si el buffer está lleno con una línea incompleta, ésta se descarta
+     * junto con el resto de sus bytes hasta el siguiente '\n', para que la
+     * cola de la línea no se entregue como si fuera una línea nueva.
+     */
+    char* espacioLibre(int& disponible);
+
+    /**
+     * @brief Confirma los bytes escritos en el espacio libre
+     * @param n Cantidad de bytes escritos
+     *
+     * Mientras se salta una línea descartada, los bytes hasta el '\n'
+     * inclusive no se confirman.
+     */
+    void confirmar(int n);
+
+    /**
+     * @brief Extrae la siguiente línea completa no vacía
+     * @param linea Inicio de la línea dentro del buffer
+     * @param longitud Longitud sin '\\r' ni '\\n'
+     * @return true si había una línea completa
+     */
+    bool siguienteLinea(const char*& linea, long& longitud);
+
+    /**
+     * @brief Acceso directo a los bytes aún no entregados
+     * @param n Cantidad de bytes pendientes
+     * @return Puntero al primer byte pendiente
+     *
+     * Permite consumir el buffer byte a byte (ej. tramas binarias).
+     */
+    const char* pendientes(int& n) const;
+
+    /**
+     * @brief Marca como consumidos bytes obtenidos con pendientes()
+     * @param n Cantidad de bytes consumidos
+     */
+    void consumir(int n);
+
+    /**
+     * @brief Líneas descartadas por ser más largas que el buffer
+     * @return Cantidad de líneas descartadas
+     */
+    long getDescartadas() const { return descartadas; }
+};
+
+#endif // ENSAMBLADOR_LINEAS_H
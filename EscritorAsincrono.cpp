@@ -0,0 +1,176 @@
+/**
+ * @file EscritorAsincrono.cpp
+ * @brief Implementación de la clase EscritorAsincrono
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "EscritorAsincrono.h"
+#include "Instrumentacion.h"
+#include <cstring>
+
+EscritorAsincrono::EscritorAsincrono(SumideroSalida* d, size_t capacidadMinima,
+                                     size_t umbralBytes, int intervaloMs)
+    : destino(d), intervalo(intervaloMs), escritura(0), lectura(0), vaciadoPedido(false),
+      terminar(false), fallo(false), escrituras(0), instalado(nullptr), anterior(nullptr) {
+    size_t capacidad = 2;
+    while (capacidad < capacidadMinima) capacidad *= 2;
+    anillo = new char[capacidad];
+    mascara = capacidad - 1;
+    umbral = (umbralBytes > 0 && umbralBytes <= capacidad) ? umbralBytes : capacidad / 2;
+    tomarZona();
+
+    hilo = std::thread(&EscritorAsincrono::ejecutar, this);
+}
+
+EscritorAsincrono::~EscritorAsincrono() {
+    cerrar();
+    delete[] anillo;
+}
+
+void EscritorAsincrono::instalar(std::ostream& flujo) {
+    flujo.flush();
+    anterior = flujo.rdbuf(this);
+    instalado = &flujo;
+}
+
+bool EscritorAsincrono::cerrar() {
+    if (hilo.joinable()) publicarZona();
+    if (instalado) {
+        instalado->rdbuf(anterior);
+        instalado = nullptr;
+    }
+    if (hilo.joinable()) {
+        {
+            std::lock_guard<std::mutex> bloqueo(mutex);
+            terminar.store(true, std::memory_order_release);
+        }
+        hayDatos.notify_one();
+        hilo.join();
+        if (!destino->vaciar()) fallo.store(true, std::memory_order_relaxed);
+    }
+    return !fallo.load(std::memory_order_relaxed);
+}
+
+void EscritorAsincrono::despertar() {
+    // Con el mutex tomado el aviso no se pierde entre la revisión y la espera del hilo
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    hayDatos.notify_one();
+}
+
+void EscritorAsincrono::publicarZona() {
+    size_t n = (size_t)(pptr() - pbase());
+    if (n == 0) return;
+
+    size_t e = escritura.load(std::memory_order_relaxed);
+    size_t l = lectura.load(std::memory_order_acquire);
+    escritura.store(e + n, std::memory_order_release);
+    setp(pptr(), epptr());
+
+    // Sólo se avisa al cruzar el umbral; lo menor lo recoge el intervalo
+    if (e - l < umbral && e + n - l >= umbral) despertar();
+}
+
+void EscritorAsincrono::tomarZona() {
+    size_t capacidad = mascara + 1;
+    int intentos = 0;
+
+    while (true) {
+        size_t e = escritura.load(std::memory_order_relaxed);
+        size_t l = lectura.load(std::memory_order_acquire);
+        size_t libres = capacidad - (e - l);
+        if (libres > 0) {
+            size_t tramo = libres;
+            if (tramo > capacidad - (e & mascara)) tramo = capacidad - (e & mascara);
+            if (tramo > umbral) tramo = umbral;
+            setp(anillo + (e & mascara), anillo + (e & mascara) + tramo);
+            return;
+        }
+
+        // Anillo lleno: el destino no da abasto y el productor espera
+        if (intentos++ == 0) despertar();
+        if (intentos < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+}
+
+EscritorAsincrono::int_type EscritorAsincrono::overflow(int_type c) {
+    publicarZona();
+    tomarZona();
+    if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    if (traits_type::to_char_type(c) == '\n') publicarZona();
+    return c;
+}
+
+std::streamsize EscritorAsincrono::xsputn(const char* datos, std::streamsize n) {
+    std::streamsize restantes = n;
+    while (restantes > 0) {
+        if (pptr() == epptr()) {
+            publicarZona();
+            tomarZona();
+        }
+        std::streamsize tramo = epptr() - pptr();
+        if (tramo > restantes) tramo = restantes;
+        memcpy(pptr(), datos, (size_t)tramo);
+        pbump((int)tramo);
+        datos += tramo;
+        restantes -= tramo;
+    }
+    // Fin de registro: el hilo escritor ya puede llevárselo
+    if (n > 0 && datos[-1] == '\n') publicarZona();
+    return n;
+}
+
+int EscritorAsincrono::sync() {
+    publicarZona();
+    size_t objetivo = escritura.load(std::memory_order_relaxed);
+    if (lectura.load(std::memory_order_acquire) == objetivo) return 0;
+
+    std::unique_lock<std::mutex> bloqueo(mutex);
+    vaciadoPedido.store(true, std::memory_order_relaxed);
+    hayDatos.notify_one();
+    // Mientras espera, este mismo hilo productor no publica nada nuevo
+    vaciado.wait(bloqueo, [&]() { return lectura.load(std::memory_order_acquire) == objetivo; });
+    return fallo.load(std::memory_order_relaxed) ? -1 : 0;
+}
+
+void EscritorAsincrono::ejecutar() {
+    size_t capacidad = mascara + 1;
+    std::unique_lock<std::mutex> bloqueo(mutex);
+
+    while (true) {
+        size_t l = lectura.load(std::memory_order_relaxed);
+        size_t e = escritura.load(std::memory_order_acquire);
+        bool saliendo = terminar.load(std::memory_order_acquire);
+        if (e == l && saliendo) break;
+
+        if (e - l < umbral && !saliendo && !vaciadoPedido.load(std::memory_order_relaxed)) {
+            // Vence el intervalo o avisan el productor (umbral), sync() o cerrar()
+            hayDatos.wait_for(bloqueo, intervalo);
+            e = escritura.load(std::memory_order_acquire);
+        }
+        vaciadoPedido.store(false, std::memory_order_relaxed);
+        if (e == l) continue;
+
+        // El destino se escribe sin el mutex: el productor no lo usa para publicar
+        bloqueo.unlock();
+        while (l != e) {
+            size_t tramo = e - l;
+            if (tramo > capacidad - (l & mascara)) tramo = capacidad - (l & mascara);
+            if (!fallo.load(std::memory_order_relaxed) && !destino->escribir(anillo + (l & mascara), (long)tramo)) {
+                fallo.store(true, std::memory_order_relaxed);
+            }
+            escrituras.fetch_add(1, std::memory_order_relaxed);
+            PRT7_CONTAR(CONTADOR_ESCRITURAS, 1);
+            l += tramo;
+        }
+        bloqueo.lock();
+        lectura.store(l, std::memory_order_release);
+        vaciado.notify_all();
+    }
+}
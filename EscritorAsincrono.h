@@ -0,0 +1,127 @@
+/**
+ * @file EscritorAsincrono.h
+ * @brief Buffer de salida que un hilo aparte vuelca a su destino
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef ESCRITOR_ASINCRONO_H
+#define ESCRITOR_ASINCRONO_H
+
+#include "SumideroSalida.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+/**
+ * @class EscritorAsincrono
+ * @brief streambuf que acumula la salida en un anillo y la escribe desde otro hilo
+ *
+ * Instalado en std::cout, los registros de progreso de cada trama se copian
+ * a un anillo reservado de antemano y quien decodifica nunca hace la
+ * llamada al sistema. La zona de escritura del streambuf (setp()) es un
+ * tramo libre del anillo, así que cada << es una copia sin atómicos; lo
+ * escrito se publica al hilo escritor al terminar un registro (un '\n'),
+ * al agotarse la zona o en sync(). El hilo vacía el anillo en su destino
+ * cuando lo publicado llega a 'umbral' bytes o, si no, cada 'intervalo';
+ * así un flujo de tramas cuesta unas pocas escrituras por segundo en lugar
+ * de una por trama. Como ColaSPSC, admite un único hilo productor a la vez.
+ *
+ * std::flush y std::endl (sync()) esperan a que todo lo escrito hasta ese
+ * momento llegue al destino, por lo que no deben usarse por trama.
+ */
+class EscritorAsincrono : public std::streambuf {
+private:
+    SumideroSalida* destino;             ///< Donde escribe el hilo
+    char* anillo;                        ///< Bytes pendientes
+    size_t mascara;                      ///< Capacidad - 1 (potencia de 2)
+    size_t umbral;                       ///< Pendientes que despiertan al hilo
+    std::chrono::milliseconds intervalo; ///< Espera máxima antes de escribir lo pendiente
+    alignas(64) std::atomic<size_t> escritura; ///< Bytes publicados (productor)
+    alignas(64) std::atomic<size_t> lectura;   ///< Bytes ya escritos (hilo escritor)
+    std::atomic<bool> vaciadoPedido;     ///< sync() espera: escribir sin esperar al umbral
+    std::atomic<bool> terminar;          ///< cerrar() pidió vaciar y terminar
+    std::atomic<bool> fallo;             ///< Alguna escritura al destino falló
+    std::atomic<long> escrituras;        ///< Escrituras hechas al destino
+    std::mutex mutex;                    ///< Protege las esperas del hilo y de sync()
+    std::condition_variable hayDatos;    ///< Despierta al hilo escritor
+    std::condition_variable vaciado;     ///< Avisa a sync() que avanzó 'lectura'
+    std::thread hilo;                    ///< Hilo escritor
+    std::ostream* instalado;             ///< Flujo cuyo streambuf se reemplazó, o nullptr
+    std::streambuf* anterior;            ///< streambuf original de ese flujo
+
+    /**
+     * @brief Bucle del hilo escritor
+     */
+    void ejecutar();
+
+    /**
+     * @brief Despierta al hilo escritor
+     */
+    void despertar();
+
+    /**
+     * @brief Publica al hilo escritor lo copiado en la zona de escritura (sólo productor)
+     *
+     * El resto de la zona sigue libre y se sigue usando.
+     */
+    void publicarZona();
+
+    /**
+     * @brief Toma como zona de escritura el siguiente tramo libre del anillo (sólo productor)
+     *
+     * El tramo es contiguo y de a lo sumo 'umbral' bytes, para que lo
+     * escrito sin salto de línea se publique igual cada tanto. Si el anillo
+     * está lleno espera a que el hilo libere espacio.
+     */
+    void tomarZona();
+
+protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* datos, std::streamsize n) override;
+    int sync() override;
+
+public:
+    /**
+     * @brief Constructor que arranca el hilo escritor
+     * @param destino Sumidero donde se escribe; debe vivir más que el escritor
+     * @param capacidadMinima Bytes del anillo; se redondea a potencia de 2
+     * @param umbralBytes Pendientes a partir de los cuales se escribe enseguida
+     * @param intervaloMs Espera máxima en milisegundos para lo que no llega al umbral
+     */
+    explicit EscritorAsincrono(SumideroSalida* destino, size_t capacidadMinima = 1 << 20,
+                               size_t umbralBytes = 1 << 16, int intervaloMs = 20);
+
+    /**
+     * @brief Destructor que llama a cerrar()
+     */
+    ~EscritorAsincrono() override;
+
+    EscritorAsincrono(const EscritorAsincrono&) = delete;
+    EscritorAsincrono& operator=(const EscritorAsincrono&) = delete;
+
+    /**
+     * @brief Reemplaza el streambuf de un flujo por este escritor
+     * @param flujo Flujo a redirigir (ej. std::cout); cerrar() lo restaura
+     */
+    void instalar(std::ostream& flujo);
+
+    /**
+     * @brief Escribe lo pendiente, termina el hilo y restaura el flujo instalado
+     * @return false si alguna escritura al destino falló
+     */
+    bool cerrar();
+
+    /**
+     * @brief Escrituras hechas al destino
+     * @return Cantidad de llamadas a SumideroSalida::escribir()
+     */
+    long getEscrituras() const { return escrituras.load(std::memory_order_relaxed); }
+};
+
+#endif // ESCRITOR_ASINCRONO_H
@@ -0,0 +1,214 @@
+/**
+ * @file Instrumentacion.cpp
+ * @brief Implementación de los histogramas y contadores de instrumentación
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "Instrumentacion.h"
+
+#ifdef PRT7_INSTRUMENTACION
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+/**
+ * @class HistogramaLatencia
+ * @brief Histograma log-lineal al estilo HDR
+ *
+ * Cada potencia de dos se divide en 2^BITS_SUBCUBETA cubetas iguales, así
+ * que el error relativo de cualquier percentil es menor a 1/16 sin importar
+ * la escala. Los valores menores a 2^BITS_SUBCUBETA tienen cubeta propia.
+ * Todas las operaciones son atómicas relajadas: varios hilos pueden
+ * registrar a la vez sin bloqueos.
+ */
+class HistogramaLatencia {
+private:
+    static const int BITS_SUBCUBETA = 4;
+    static const int SUBCUBETAS = 1 << BITS_SUBCUBETA;
+    static const int NUM_CUBETAS = (64 - BITS_SUBCUBETA + 1) * SUBCUBETAS;
+
+    std::atomic<unsigned long long> cubetas[NUM_CUBETAS]; ///< Conteo por cubeta
+    std::atomic<unsigned long long> conteo;               ///< Muestras registradas
+    std::atomic<unsigned long long> suma;                 ///< Suma de las muestras
+    std::atomic<unsigned long long> maximo;               ///< Mayor muestra
+
+    /**
+     * @brief Cubeta que corresponde a un valor
+     * @param valor Valor en nanosegundos
+     * @return Índice de cubeta
+     */
+    static int indice(unsigned long long valor) {
+        if (valor < (unsigned long long)SUBCUBETAS) return (int)valor;
+        int exponente = 63 - __builtin_clzll(valor);
+        int desplazamiento = exponente - BITS_SUBCUBETA;
+        int sub = (int)(valor >> desplazamiento) - SUBCUBETAS;
+        return (desplazamiento + 1) * SUBCUBETAS + sub;
+    }
+
+    /**
+     * @brief Mayor valor que cae en una cubeta
+     * @param i Índice de cubeta
+     * @return Límite superior de la cubeta
+     */
+    static unsigned long long limiteSuperior(int i) {
+        if (i < SUBCUBETAS) return (unsigned long long)i;
+        int desplazamiento = i / SUBCUBETAS - 1;
+        unsigned long long base = (unsigned long long)(SUBCUBETAS + i % SUBCUBETAS) << desplazamiento;
+        return base + ((1ULL << desplazamiento) - 1);
+    }
+
+public:
+    HistogramaLatencia() : conteo(0), suma(0), maximo(0) {
+        for (int i = 0; i < NUM_CUBETAS; i++) {
+            cubetas[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Registra una muestra
+     * @param valor Duración en nanosegundos
+     */
+    void registrar(unsigned long long valor) {
+        cubetas[indice(valor)].fetch_add(1, std::memory_order_relaxed);
+        conteo.fetch_add(1, std::memory_order_relaxed);
+        suma.fetch_add(valor, std::memory_order_relaxed);
+        
+        unsigned long long actual = maximo.load(std::memory_order_relaxed);
+        while (valor > actual && !maximo.compare_exchange_weak(actual, valor, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Cantidad de muestras
+     * @return Muestras registradas
+     */
+    unsigned long long getConteo() const { return conteo.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Promedio de las muestras
+     * @return Promedio en nanosegundos
+     */
+    double getPromedio() const {
+        unsigned long long n = getConteo();
+        return n ? (double)suma.load(std::memory_order_relaxed) / n : 0.0;
+    }
+
+    /**
+     * @brief Mayor muestra registrada
+     * @return Máximo en nanosegundos
+     */
+    unsigned long long getMaximo() const { return maximo.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Valor bajo el cual cae una fracción de las muestras
+     * @param fraccion Fracción en [0, 1] (ej. 0.99)
+     * @return Límite superior de la cubeta del percentil
+     */
+    unsigned long long percentil(double fraccion) const {
+        unsigned long long n = getConteo();
+        if (n == 0) return 0;
+        unsigned long long objetivo = (unsigned long long)(fraccion * n);
+        if (objetivo < 1) objetivo = 1;
+        
+        unsigned long long acumulado = 0;
+        for (int i = 0; i < NUM_CUBETAS; i++) {
+            acumulado += cubetas[i].load(std::memory_order_relaxed);
+            if (acumulado >= objetivo) {
+                unsigned long long limite = limiteSuperior(i);
+                unsigned long long maximoActual = getMaximo();
+                return limite < maximoActual ? limite : maximoActual;
+            }
+        }
+        return getMaximo();
+    }
+};
+
+/**
+ * @brief Nombres de las etapas para el resumen
+ */
+static const char* NOMBRES_ETAPAS[NUM_ETAPAS] = {
+    "lectura", "parseo", "procesar", "salida", "total"
+};
+
+/**
+ * @brief Nombres de los contadores para el resumen
+ */
+static const char* NOMBRES_CONTADORES[NUM_CONTADORES] = {
+    "tramas", "malformadas", "bytes", "escrituras"
+};
+
+static HistogramaLatencia histogramas[NUM_ETAPAS];
+static std::atomic<unsigned long long> contadores[NUM_CONTADORES];
+
+/**
+ * @brief Bandera que activa el manejador de SIGUSR1
+ */
+static volatile std::sig_atomic_t volcadoPedido = 0;
+
+unsigned long long instrumentacionAhora() {
+    return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void instrumentacionRegistrar(EtapaInstrumentada etapa, unsigned long long nanosegundos) {
+    histogramas[etapa].registrar(nanosegundos);
+}
+
+void instrumentacionContar(ContadorInstrumentado contador, unsigned long long n) {
+    contadores[contador].fetch_add(n, std::memory_order_relaxed);
+}
+
+void instrumentacionVolcar() {
+    fprintf(stderr, "--- Instrumentacion PRT-7 (microsegundos) ---\n");
+    fprintf(stderr, "%-9s %12s %10s %10s %10s %10s %10s %10s\n",
+            "etapa", "muestras", "promedio", "p50", "p90", "p99", "p99.9", "maximo");
+    for (int i = 0; i < NUM_ETAPAS; i++) {
+        const HistogramaLatencia& h = histogramas[i];
+        if (h.getConteo() == 0) continue;
+        fprintf(stderr, "%-9s %12llu %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+                NOMBRES_ETAPAS[i], h.getConteo(), h.getPromedio() / 1e3,
+                h.percentil(0.50) / 1e3, h.percentil(0.90) / 1e3, h.percentil(0.99) / 1e3,
+                h.percentil(0.999) / 1e3, h.getMaximo() / 1e3);
+    }
+    for (int i = 0; i < NUM_CONTADORES; i++) {
+        fprintf(stderr, "%s: %llu\n", NOMBRES_CONTADORES[i],
+                contadores[i].load(std::memory_order_relaxed));
+    }
+    fflush(stderr);
+}
+
+#ifdef SIGUSR1
+/**
+ * @brief Manejador de SIGUSR1: sólo pide el volcado
+ * @param senal Número de señal recibida
+ */
+static void manejarVolcado(int senal) {
+    (void)senal;
+    volcadoPedido = 1;
+}
+#endif
+
+void instrumentacionInstalar() {
+    std::atexit(instrumentacionVolcar);
+    
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, manejarVolcado);
+    std::thread vigilante([]() {
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (volcadoPedido) {
+                volcadoPedido = 0;
+                instrumentacionVolcar();
+            }
+        }
+    });
+    vigilante.detach();
+#endif
+}
+
+#endif // PRT7_INSTRUMENTACION
@@ -0,0 +1,93 @@
+/**
+ * @file Instrumentacion.h
+ * @brief Histogramas de latencia por etapa y contadores del decodificador
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Sólo existe si se compila con PRT7_INSTRUMENTACION (opción de CMake del
+ * mismo nombre). Sin ella las macros PRT7_* se expanden a nada y no queda
+ * ni una instrucción en el binario.
+ */
+
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+
+/**
+ * @enum EtapaInstrumentada
+ * @brief Etapas del camino de un byte desde el puerto hasta la lista
+ */
+enum EtapaInstrumentada {
+    ETAPA_LECTURA,   ///< Llamada de lectura al puerto (incluye la espera de datos)
+    ETAPA_PARSEO,    ///< Armado de una trama a partir de los bytes recibidos
+    ETAPA_PROCESAR,  ///< Aplicar la trama al rotor y a la lista (incluye la salida)
+    ETAPA_SALIDA,    ///< Escribir el progreso en consola
+    ETAPA_TOTAL,     ///< Desde que llegan los bytes hasta que la trama quedó aplicada
+    NUM_ETAPAS
+};
+
+/**
+ * @enum ContadorInstrumentado
+ * @brief Contadores globales
+ */
+enum ContadorInstrumentado {
+    CONTADOR_TRAMAS,      ///< Tramas aplicadas
+    CONTADOR_MALFORMADAS, ///< Líneas o tramas descartadas
+    CONTADOR_BYTES,       ///< Bytes leídos de la fuente
+    CONTADOR_ESCRITURAS,  ///< Escrituras de EscritorAsincrono a su destino
+    NUM_CONTADORES
+};
+
+#ifdef PRT7_INSTRUMENTACION
+
+/**
+ * @brief Marca de tiempo monotónica
+ * @return Nanosegundos desde un origen arbitrario
+ */
+unsigned long long instrumentacionAhora();
+
+/**
+ * @brief Registra la duración de una etapa en su histograma
+ * @param etapa Etapa medida
+ * @param nanosegundos Duración
+ */
+void instrumentacionRegistrar(EtapaInstrumentada etapa, unsigned long long nanosegundos);
+
+/**
+ * @brief Incrementa un contador
+ * @param contador Contador a incrementar
+ * @param n Cantidad a sumar
+ */
+void instrumentacionContar(ContadorInstrumentado contador, unsigned long long n);
+
+/**
+ * @brief Escribe el resumen de histogramas y contadores en stderr
+ */
+void instrumentacionVolcar();
+
+/**
+ * @brief Programa el volcado al terminar el programa y al recibir SIGUSR1
+ *
+ * El manejador de la señal sólo activa una bandera; un hilo auxiliar la
+ * revisa y hace el volcado fuera del contexto de la señal.
+ */
+void instrumentacionInstalar();
+
+/// Guarda el instante de inicio en una variable local
+#define PRT7_MARCA(variable) unsigned long long variable = instrumentacionAhora()
+/// Registra en la etapa el tiempo transcurrido desde la marca
+#define PRT7_MEDIR(etapa, variable) instrumentacionRegistrar((etapa), instrumentacionAhora() - (variable))
+/// Suma n al contador
+#define PRT7_CONTAR(contador, n) instrumentacionContar((contador), (unsigned long long)(n))
+/// Activa el volcado al salir y con SIGUSR1
+#define PRT7_INSTALAR_INSTRUMENTACION() instrumentacionInstalar()
+
+#else
+
+#define PRT7_MARCA(variable)
+#define PRT7_MEDIR(etapa, variable) ((void)0)
+#define PRT7_CONTAR(contador, n) ((void)0)
+#define PRT7_INSTALAR_INSTRUMENTACION() ((void)0)
+
+#endif // PRT7_INSTRUMENTACION
+
+#endif // INSTRUMENTACION_H
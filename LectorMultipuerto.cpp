@@ -0,0 +1,172 @@
+/**
+ * @file LectorMultipuerto.cpp
+ * @brief Implementación de la clase LectorMultipuerto
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "LectorMultipuerto.h"
+#include "MotorMultiflujo.h"
+#include "ParserTramas.h"
+#include "PuertoSerial.h"
+#include "Instrumentacion.h"
+
+#ifdef __linux__
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/epoll.h>
+#endif
+
+LectorMultipuerto::LectorMultipuerto()
+    : dispositivos(nullptr), numDispositivos(0), capacidad(0), abiertos(0), epfd(-1),
+      motor(nullptr) {
+#ifdef __linux__
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+#endif
+}
+
+LectorMultipuerto::~LectorMultipuerto() {
+    for (int i = 0; i < numDispositivos; i++) {
+        cerrarDispositivo(dispositivos[i]);
+        delete dispositivos[i];
+    }
+    delete[] dispositivos;
+#ifdef __linux__
+    if (epfd != -1) close(epfd);
+#endif
+}
+
+#ifdef __linux__
+bool LectorMultipuerto::agregar(const char* ruta, const ConfiguracionSerial& configuracion) {
+    if (epfd == -1) return false;
+    
+    int fd = abrirPuertoSerial(ruta, configuracion);
+    if (fd == -1) return false;
+    
+    int banderas = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, banderas | O_NONBLOCK);
+    
+    DispositivoSerial* dispositivo = new DispositivoSerial(ruta, (unsigned long)numDispositivos, fd);
+    dispositivo->carga.configurarProgreso(PROGRESO_APAGADO);
+    
+    struct epoll_event evento;
+    evento.events = EPOLLIN;
+    evento.data.ptr = dispositivo;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &evento) == -1) {
+        close(fd);
+        delete dispositivo;
+        return false;
+    }
+    
+    if (numDispositivos == capacidad) {
+        capacidad = capacidad ? capacidad * 2 : 8;
+        DispositivoSerial** nuevo = new DispositivoSerial*[capacidad];
+        for (int i = 0; i < numDispositivos; i++) {
+            nuevo[i] = dispositivos[i];
+        }
+        delete[] dispositivos;
+        dispositivos = nuevo;
+    }
+    dispositivos[numDispositivos++] = dispositivo;
+    abiertos++;
+    return true;
+}
+
+void LectorMultipuerto::cerrarDispositivo(DispositivoSerial* dispositivo) {
+    if (dispositivo->fd == -1) return;
+    
+    epoll_ctl(epfd, EPOLL_CTL_DEL, dispositivo->fd, nullptr);
+    close(dispositivo->fd);
+    dispositivo->fd = -1;
+    abiertos--;
+}
+
+bool LectorMultipuerto::atender(DispositivoSerial* dispositivo) {
+    const int TRAMAS_POR_ENVIO = 256;
+    TramaValor lote[TRAMAS_POR_ENVIO];
+    
+    while (true) {
+        int disponible;
+        char* destino = dispositivo->lector.espacioLibre(disponible);
+        PRT7_MARCA(inicioLectura);
+        ssize_t leidos = read(dispositivo->fd, destino, disponible);
+        
+        if (leidos > 0) {
+            PRT7_MEDIR(ETAPA_LECTURA, inicioLectura);
+            PRT7_CONTAR(CONTADOR_BYTES, leidos);
+            PRT7_MARCA(llegada);
+            dispositivo->lector.confirmar((int)leidos);
+            
+            TramaValor trama;
+            int enLote = 0;
+            while (true) {
+                PRT7_MARCA(inicioParseo);
+                if (!dispositivo->lector.siguiente(trama)) break;
+                PRT7_MEDIR(ETAPA_PARSEO, inicioParseo);
+                dispositivo->tramas++;
+                
+                if (motor) {
+                    // Un envío por lectura (o cada TRAMAS_POR_ENVIO): el
+                    // candado del trabajador se toma una vez por lote
+                    lote[enLote++] = trama;
+                    if (enLote == TRAMAS_POR_ENVIO) {
+                        motor->enviarLote(dispositivo->id, lote, enLote);
+                        enLote = 0;
+                    }
+                    continue;
+                }
+                despacharTrama(trama, &dispositivo->carga, &dispositivo->rotor);
+                PRT7_MEDIR(ETAPA_TOTAL, llegada);
+            }
+            if (enLote > 0) motor->enviarLote(dispositivo->id, lote, enLote);
+        } else if (leidos == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        } else if (leidos == -1 && errno == EINTR) {
+            continue;
+        } else {
+            // Fin de archivo o error: el dispositivo se desconectó
+            return false;
+        }
+    }
+}
+
+void LectorMultipuerto::ejecutar(const volatile std::sig_atomic_t* detener) {
+    const int MAX_EVENTOS = 64;
+    struct epoll_event eventos[MAX_EVENTOS];
+    
+    while (abiertos > 0 && !(detener && *detener)) {
+        int listos = epoll_wait(epfd, eventos, MAX_EVENTOS, 200);
+        if (listos == -1) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        
+        for (int i = 0; i < listos; i++) {
+            DispositivoSerial* dispositivo = static_cast<DispositivoSerial*>(eventos[i].data.ptr);
+            if (dispositivo->fd == -1) continue;
+            
+            bool sigue = true;
+            if (eventos[i].events & EPOLLIN) {
+                sigue = atender(dispositivo);
+            } else if (eventos[i].events & (EPOLLHUP | EPOLLERR)) {
+                sigue = false;
+            }
+            
+            if (!sigue) cerrarDispositivo(dispositivo);
+        }
+    }
+}
+#else
+bool LectorMultipuerto::agregar(const char*, const ConfiguracionSerial&) {
+    return false;
+}
+
+void LectorMultipuerto::cerrarDispositivo(DispositivoSerial*) {}
+
+bool LectorMultipuerto::atender(DispositivoSerial*) {
+    return false;
+}
+
+void LectorMultipuerto::ejecutar(const volatile std::sig_atomic_t*) {}
+#endif
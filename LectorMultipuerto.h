@@ -0,0 +1,127 @@
+/**
+ * @file LectorMultipuerto.h
+ * @brief Lector de varios puertos seriales basado en eventos (epoll)
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef LECTOR_MULTIPUERTO_H
+#define LECTOR_MULTIPUERTO_H
+
+#include <csignal>
+#include "LectorTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "PuertoSerial.h"
+
+class MotorMultiflujo;
+
+/**
+ * @struct DispositivoSerial
+ * @brief Estado independiente de cada puerto vigilado
+ */
+struct DispositivoSerial {
+    const char* ruta;             ///< Ruta del dispositivo (ej. "/dev/ttyUSB0")
+    unsigned long id;             ///< Índice de registro; id del flujo en el motor
+    int fd;                       ///< Descriptor abierto o -1 si ya se cerró
+    LectorTramas lector;          ///< Armado de tramas (texto o binario) de este puerto
+    RotorDeMapeo rotor;           ///< Rotor propio del dispositivo
+    ListaDeCarga carga;           ///< Mensaje decodificado del dispositivo
+    long tramas;                  ///< Tramas válidas procesadas
+
+    /**
+     * @brief Constructor
+     * @param r Ruta del dispositivo
+     * @param identificador Índice de registro
+     * @param descriptor Descriptor ya abierto
+     */
+    DispositivoSerial(const char* r, unsigned long identificador, int descriptor)
+        : ruta(r), id(identificador), fd(descriptor), tramas(0) {}
+};
+
+/**
+ * @class LectorMultipuerto
+ * @brief Vigila muchos puertos seriales desde un solo hilo
+ *
+ * Los descriptores se abren en modo no bloqueante y se registran en una
+ * instancia de epoll. Cuando un puerto tiene datos se leen hasta vaciarlo,
+ * se arman las tramas en su propio LectorTramas y cada trama se
+ * despacha al rotor y a la lista de carga de ese mismo dispositivo, o bien
+ * se entrega a un MotorMultiflujo para decodificar los puertos en paralelo.
+ * Sólo está disponible en Linux.
+ */
+class LectorMultipuerto {
+private:
+    DispositivoSerial** dispositivos; ///< Dispositivos registrados
+    int numDispositivos;              ///< Cantidad de dispositivos registrados
+    int capacidad;                    ///< Capacidad del arreglo de dispositivos
+    int abiertos;                     ///< Dispositivos que siguen abiertos
+    int epfd;                         ///< Descriptor de epoll
+    MotorMultiflujo* motor;           ///< Motor que decodifica las tramas, o nullptr
+
+    /**
+     * @brief Lee todo lo disponible en un dispositivo y procesa sus tramas
+     * @param dispositivo Dispositivo con datos pendientes
+     * @return false si el dispositivo se cerró o falló
+     */
+    bool atender(DispositivoSerial* dispositivo);
+
+    /**
+     * @brief Quita un dispositivo de epoll y cierra su descriptor
+     * @param dispositivo Dispositivo a cerrar
+     */
+    void cerrarDispositivo(DispositivoSerial* dispositivo);
+
+public:
+    /**
+     * @brief Constructor que crea la instancia de epoll
+     */
+    LectorMultipuerto();
+
+    /**
+     * @brief Destructor que cierra todos los puertos y libera su estado
+     */
+    ~LectorMultipuerto();
+
+    LectorMultipuerto(const LectorMultipuerto&) = delete;
+    LectorMultipuerto& operator=(const LectorMultipuerto&) = delete;
+
+    /**
+     * @brief Abre un puerto serial y lo agrega a la vigilancia
+     * @param ruta Ruta del dispositivo (debe seguir siendo válida)
+     * @param configuracion Velocidad y VMIN/VTIME de la línea (se ignora su ruta)
+     * @return true si se pudo abrir y registrar
+     */
+    bool agregar(const char* ruta, const ConfiguracionSerial& configuracion);
+
+    /**
+     * @brief Decodifica las tramas en un motor en lugar de en este hilo
+     * @param m Motor (debe seguir vivo durante ejecutar()); cada dispositivo
+     *        es el flujo con id igual a su índice de registro
+     *
+     * Con motor, el rotor y la carga de cada dispositivo quedan sin usar: el
+     * mensaje está en la sesión del motor, MotorMultiflujo::buscarSesion(id).
+     */
+    void usarMotor(MotorMultiflujo* m) { motor = m; }
+
+    /**
+     * @brief Atiende los puertos hasta que todos se cierren o se pida detener
+     * @param detener Bandera que se revisa al menos cada 200 ms
+     */
+    void ejecutar(const volatile std::sig_atomic_t* detener);
+
+    /**
+     * @brief Cantidad de dispositivos registrados
+     * @return Número de dispositivos
+     */
+    int getNumDispositivos() const { return numDispositivos; }
+
+    /**
+     * @brief Acceso al estado de un dispositivo
+     * @param i Índice en orden de registro
+     * @return Referencia al dispositivo
+     */
+    const DispositivoSerial& getDispositivo(int i) const { return *dispositivos[i]; }
+};
+
+#endif // LECTOR_MULTIPUERTO_H
@@ -0,0 +1,147 @@
+/**
+ * @file LectorTramas.cpp
+ * @brief Implementación de la clase LectorTramas
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "LectorTramas.h"
+#include "ParserTramas.h"
+#include "Instrumentacion.h"
+#include <cstring>
+
+LectorTramas::LectorTramas()
+    : protocolo(PROTOCOLO_DESCONOCIDO), malformadas(0), numRotores(1), enLote(0), posLote(0) {}
+
+/**
+ * @brief Prueba si los bytes tras una sincronía forman una trama binaria
+ * @param datos Bytes que siguen al byte de sincronía
+ * @param n Cantidad de bytes
+ * @return 1 si forman una trama válida, 0 si falta recibir más, -1 si no
+ */
+static int probarBinario(const char* datos, int n) {
+    int i = 0;
+    while (i < n && (unsigned char)datos[i] == PRT7_SINCRONIA) i++;
+    if (i == n) return 0;
+    // En binario el salto de línea siempre va escapado
+    if (datos[i] == '\n' || datos[i] == '\r') return -1;
+
+    DecodificadorBinario prueba;
+    TramaValor trama;
+    for (; i < n; i++) {
+        if (prueba.empujar((unsigned char)datos[i], trama)) {
+            return prueba.getMalformadas() == 0 ? 1 : -1;
+        }
+        if (prueba.getMalformadas() > 0) return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Prueba si una línea de texto completa empieza en datos
+ * @param datos Bytes desde una 'L' o 'M'
+ * @param n Cantidad de bytes
+ * @return 1 si la línea es una trama válida, 0 si falta su '\n', -1 si no
+ *
+ * Una trama ocupa a lo sumo PRT7_MAX_BYTES_LINEA bytes: sin salto en ese
+ * tramo no es una línea de texto y no se sigue esperando.
+ */
+static int probarTexto(const char* datos, int n) {
+    int limite = n < PRT7_MAX_BYTES_LINEA ? n : PRT7_MAX_BYTES_LINEA;
+    const char* salto = static_cast<const char*>(memchr(datos, '\n', limite));
+    if (!salto) return limite == n ? 0 : -1;
+    long longitud = salto - datos;
+    if (longitud > 0 && datos[longitud - 1] == '\r') longitud--;
+    TramaValor trama;
+    return parsearTramaValor(datos, longitud, trama) ? 1 : -1;
+}
+
+void LectorTramas::detectar() {
+    int n;
+    const char* datos = entrada.pendientes(n);
+    
+    // Un lector que se une a un flujo ya iniciado puede ver 'L' o 'M' dentro
+    // de una trama binaria, o bytes sueltos de una línea cortada: el formato
+    // se decide con la primera trama completa y válida, no con un solo byte
+    int primeraIndecisa = -1;
+    for (int i = 0; i < n; i++) {
+        unsigned char byte = (unsigned char)datos[i];
+        int resultado;
+        if (byte == PRT7_SINCRONIA) {
+            resultado = probarBinario(datos + i + 1, n - i - 1);
+            if (resultado > 0) protocolo = PROTOCOLO_BINARIO;
+        } else if (byte == 'L' || byte == 'M') {
+            resultado = probarTexto(datos + i, n - i);
+            if (resultado > 0) protocolo = PROTOCOLO_TEXTO;
+        } else {
+            continue;
+        }
+        
+        if (resultado > 0) {
+            entrada.consumir(i);
+            return;
+        }
+        if (resultado == 0 && primeraIndecisa < 0) primeraIndecisa = i;
+    }
+    
+    // Se conserva desde el primer candidato que aún puede completarse
+    entrada.consumir(primeraIndecisa < 0 ? n : primeraIndecisa);
+}
+
+long LectorTramas::empujar(const char* datos, long n) {
+    // Una sola vez: pedir espacio con el buffer lleno lo descartaría como
+    // una línea demasiado larga, aunque contenga tramas sin extraer
+    int disponible;
+    char* destino = entrada.espacioLibre(disponible);
+    
+    long copiar = n < disponible ? n : disponible;
+    memcpy(destino, datos, copiar);
+    entrada.confirmar((int)copiar);
+    return copiar;
+}
+
+bool LectorTramas::siguiente(TramaValor& trama) {
+    while (extraer(trama)) {
+        if (trama.tipo != TRAMA_MAP || trama.rotor < numRotores) return true;
+        malformadas++;
+        PRT7_CONTAR(CONTADOR_MALFORMADAS, 1);
+    }
+    return false;
+}
+
+bool LectorTramas::extraer(TramaValor& trama) {
+    if (posLote < enLote) {
+        trama = lote[posLote++];
+        return true;
+    }
+    
+    if (protocolo == PROTOCOLO_DESCONOCIDO) {
+        detectar();
+    }
+    
+    if (protocolo == PROTOCOLO_TEXTO) {
+        int n;
+        const char* datos = entrada.pendientes(n);
+        long consumidos;
+        enLote = (int)parsearBloqueTramas(datos, n, lote, TRAMAS_POR_LOTE, consumidos, malformadas);
+        posLote = 0;
+        entrada.consumir((int)consumidos);
+        
+        if (enLote == 0) return false;
+        trama = lote[posLote++];
+        return true;
+    }
+    
+    if (protocolo == PROTOCOLO_BINARIO) {
+        int n;
+        const char* datos = entrada.pendientes(n);
+        for (int i = 0; i < n; i++) {
+            if (binario.empujar((unsigned char)datos[i], trama)) {
+                entrada.consumir(i + 1);
+                return true;
+            }
+        }
+        entrada.consumir(n);
+    }
+    return false;
+}
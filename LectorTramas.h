@@ -0,0 +1,123 @@
+/**
+ * @file LectorTramas.h
+ * @brief Lector de tramas con detección automática de formato texto o binario
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef LECTOR_TRAMAS_H
+#define LECTOR_TRAMAS_H
+
+#include "EnsambladorLineas.h"
+#include "ProtocoloBinario.h"
+#include "TramaValor.h"
+
+/**
+ * @enum ProtocoloPRT7
+ * @brief Formato detectado en el flujo de bytes
+ */
+enum ProtocoloPRT7 {
+    PROTOCOLO_DESCONOCIDO, ///< Aún no llega una trama completa
+    PROTOCOLO_TEXTO,       ///< Líneas "L,X" / "M,N"
+    PROTOCOLO_BINARIO      ///< Formato compacto de ProtocoloBinario.h
+};
+
+/**
+ * @class LectorTramas
+ * @brief Convierte bytes crudos del puerto en tramas por valor
+ *
+ * Los bytes se escriben directamente en el buffer interno (espacioLibre()
+ * y confirmar()) y las tramas se obtienen con siguiente(). El formato se
+ * decide con la primera trama completa: PRT7_SINCRONIA seguido de una
+ * trama binaria válida indica binario y una línea "L,X" / "M,N" válida
+ * indica texto; los bytes anteriores se descartan como ruido.
+ * En texto, todas las líneas completas del buffer se parsean juntas con
+ * parsearBloqueTramas() y siguiente() las entrega desde un lote interno.
+ * Un MAP dirigido a un rotor que el decodificador no tiene ("M,R,N" con R
+ * fuera de la cadena) no se entrega y se cuenta como mal formado.
+ */
+class LectorTramas {
+private:
+    static const int TRAMAS_POR_LOTE = 64; ///< Tramas de texto parseadas por pasada
+
+    EnsambladorLineas entrada;    ///< Bytes recibidos pendientes de procesar
+    DecodificadorBinario binario; ///< Máquina de estados del formato binario
+    ProtocoloPRT7 protocolo;      ///< Formato detectado
+    long malformadas;             ///< Líneas de texto no reconocidas y MAP a rotores inexistentes
+    int numRotores;               ///< Rotores del decodificador; los MAP a otros son mal formados
+    TramaValor lote[TRAMAS_POR_LOTE]; ///< Tramas de texto ya parseadas
+    int enLote;                   ///< Tramas válidas en lote
+    int posLote;                  ///< Siguiente trama de lote a entregar
+
+    /**
+     * @brief Extrae la siguiente trama sin filtrar por rotor
+     * @param trama Trama extraída
+     * @return false si no hay una trama completa en los bytes recibidos
+     */
+    bool extraer(TramaValor& trama);
+
+    /**
+     * @brief Decide el formato a partir de los bytes pendientes
+     *
+     * Si todavía no hay una trama completa, conserva los bytes desde el
+     * primer candidato y el formato sigue sin decidirse.
+     */
+    void detectar();
+
+public:
+    /**
+     * @brief Constructor que deja el formato sin detectar
+     */
+    LectorTramas();
+
+    /**
+     * @brief Fija la cantidad de rotores del decodificador que recibe las tramas
+     * @param n Rotores de la cadena (1 por omisión)
+     */
+    void configurarRotores(int n) { numRotores = n; }
+
+    /**
+     * @brief Obtiene espacio para escribir bytes recibidos
+     * @param disponible Bytes que se pueden escribir
+     * @return Puntero donde escribir
+     */
+    char* espacioLibre(int& disponible) { return entrada.espacioLibre(disponible); }
+
+    /**
+     * @brief Confirma los bytes escritos en espacioLibre()
+     * @param n Cantidad de bytes escritos
+     */
+    void confirmar(int n) { entrada.confirmar(n); }
+
+    /**
+     * @brief Copia bytes al buffer interno
+     * @param datos Bytes recibidos
+     * @param n Cantidad de bytes
+     * @return Bytes aceptados (puede ser menor a n si el buffer se llenó;
+     *         hay que extraer tramas con siguiente() antes de reintentar)
+     */
+    long empujar(const char* datos, long n);
+
+    /**
+     * @brief Extrae la siguiente trama completa
+     * @param trama Trama extraída
+     * @return false si no hay una trama completa en los bytes recibidos
+     */
+    bool siguiente(TramaValor& trama);
+
+    /**
+     * @brief Formato detectado
+     * @return Protocolo del flujo
+     */
+    ProtocoloPRT7 getProtocolo() const { return protocolo; }
+
+    /**
+     * @brief Tramas descartadas por estar mal formadas
+     * @return Cantidad de líneas, rotaciones o MAP a otros rotores descartados
+     */
+    long getMalformadas() const {
+        return malformadas + entrada.getDescartadas() + binario.getMalformadas();
+    }
+};
+
+#endif // LECTOR_TRAMAS_H
@@ -6,21 +6,50 @@
  */
 
 #include "ListaDeCarga.h"
+#include "BusquedaIncremental.h"
+#include <cstring>
 #include <iostream>
 
-ListaDeCarga::ListaDeCarga() : cabeza(nullptr), cola(nullptr) {}
+ListaDeCarga::ListaDeCarga()
+    : cabeza(nullptr), cola(nullptr), longitud(0), sumidero(nullptr), retener(0),
+      bloqueFlujo(nullptr), emitidos(0), errorFlujo(false), marcas(nullptr),
+      capacidadMarcas(0), primeraMarca(0), finMarcas(0), siguienteMarca(0) {}
 
 ListaDeCarga::~ListaDeCarga() {
-    NodoCarga* actual = cabeza;
-    while (actual) {
-        NodoCarga* temp = actual;
-        actual = actual->siguiente;
-        delete temp;
+    // El pool devuelve todos los bloques de nodos en su destructor
+    delete[] bloqueFlujo;
+    delete[] marcas;
+}
+
+void ListaDeCarga::agregarMarca(NodoCarga* nodo, long posicion) {
+    if (finMarcas == capacidadMarcas) {
+        long vigentes = finMarcas - primeraMarca;
+        if (primeraMarca >= vigentes && primeraMarca > 0) {
+            // En modo flujo la cabeza avanza: se reaprovecha el frente
+            memmove(marcas, marcas + primeraMarca, vigentes * sizeof(MarcaIndice));
+        } else {
+            long nuevaCapacidad = capacidadMarcas ? capacidadMarcas * 2 : 64;
+            MarcaIndice* nuevas = new MarcaIndice[nuevaCapacidad];
+            if (vigentes > 0) {
+                memcpy(nuevas, marcas + primeraMarca, vigentes * sizeof(MarcaIndice));
+            }
+            delete[] marcas;
+            marcas = nuevas;
+            capacidadMarcas = nuevaCapacidad;
+        }
+        primeraMarca = 0;
+        finMarcas = vigentes;
     }
+    
+    marcas[finMarcas].nodo = nodo;
+    marcas[finMarcas].posicion = posicion;
+    finMarcas++;
+    siguienteMarca = posicion + PASO_INDICE;
 }
 
 void ListaDeCarga::insertarAlFinal(char dato) {
-    NodoCarga* nuevo = new NodoCarga(dato);
+    NodoCarga* nuevo = pool.crear(dato);
+    longitud++;
     
     if (!cabeza) {
         cabeza = cola = nuevo;
@@ -29,30 +58,69 @@ void ListaDeCarga::insertarAlFinal(char dato) {
         nuevo->previo = cola;
         cola = nuevo;
     }
+    indexarCola(nuevo);
+    
+    progreso.registrar(dato);
+    revisarFlujo();
 }
 
-void ListaDeCarga::imprimirMensaje() {
-    NodoCarga* actual = cabeza;
-    while (actual) {
-        std::cout << actual->dato;
-        actual = actual->siguiente;
+void ListaDeCarga::insertarBloque(const char* datos, long n) {
+    if (n <= 0) return;
+    
+    long i = 0;
+    long posicion = emitidos + longitud;
+    if (!cabeza) {
+        cabeza = cola = pool.crear(datos[0]);
+        if (posicion >= siguienteMarca) agregarMarca(cabeza, posicion);
+        i = 1;
+    }
+    
+    // Enlazar e indexar los nodos nuevos en un solo recorrido
+    NodoCarga* ultimo = cola;
+    for (; i < n; i++) {
+        NodoCarga* nuevo = pool.crear(datos[i]);
+        nuevo->previo = ultimo;
+        ultimo->siguiente = nuevo;
+        ultimo = nuevo;
+        if (posicion + i >= siguienteMarca) agregarMarca(nuevo, posicion + i);
     }
+    cola = ultimo;
+    longitud += n;
+    
+    if (progreso.getModo() != PROGRESO_APAGADO) {
+        for (i = 0; i < n; i++) {
+            progreso.registrar(datos[i]);
+        }
+    }
+    revisarFlujo();
+}
+
+void ListaDeCarga::imprimirMensaje() {
+    escribirMensaje(std::cout);
     std::cout << std::endl;
 }
 
-char* ListaDeCarga::obtenerMensaje() {
-    // Contar caracteres
-    int longitud = 0;
+void ListaDeCarga::escribirMensaje(std::ostream& salida) const {
+    char bloque[4096];
+    int usados = 0;
+    
     NodoCarga* actual = cabeza;
     while (actual) {
-        longitud++;
+        bloque[usados++] = actual->dato;
+        if (usados == (int)sizeof(bloque)) {
+            salida.write(bloque, usados);
+            usados = 0;
+        }
         actual = actual->siguiente;
     }
-    
+    salida.write(bloque, usados);
+}
+
+char* ListaDeCarga::obtenerMensaje() {
     // Crear cadena
     char* mensaje = new char[longitud + 1];
-    actual = cabeza;
-    int i = 0;
+    NodoCarga* actual = cabeza;
+    long i = 0;
     while (actual) {
         mensaje[i++] = actual->dato;
         actual = actual->siguiente;
@@ -60,4 +128,222 @@ char* ListaDeCarga::obtenerMensaje() {
     mensaje[i] = '\0';
     
     return mensaje;
-}
\ No newline at end of file
+}
+
+void ListaDeCarga::concatenar(ListaDeCarga& otra) {
+    if (&otra == this || !otra.cabeza) return;
+    
+    if (progreso.getModo() != PROGRESO_APAGADO) {
+        NodoCarga* actual = otra.cabeza;
+        while (actual) {
+            progreso.registrar(actual->dato);
+            actual = actual->siguiente;
+        }
+    }
+    
+    if (!cabeza) {
+        cabeza = otra.cabeza;
+    } else {
+        cola->siguiente = otra.cabeza;
+        otra.cabeza->previo = cola;
+    }
+    
+    // Las marcas de la otra lista siguen apuntando a nodos válidos: se
+    // copian corridas a la posición que ocupan ahora, sin recorrer sus nodos
+    long desplazamiento = emitidos + longitud - otra.emitidos;
+    if (otra.primeraMarca == otra.finMarcas ||
+        otra.marcas[otra.primeraMarca].nodo != otra.cabeza) {
+        agregarMarca(otra.cabeza, emitidos + longitud);
+    }
+    for (long j = otra.primeraMarca; j < otra.finMarcas; j++) {
+        agregarMarca(otra.marcas[j].nodo, otra.marcas[j].posicion + desplazamiento);
+    }
+    siguienteMarca = otra.siguienteMarca + desplazamiento;
+    
+    cola = otra.cola;
+    longitud += otra.longitud;
+    pool.absorber(otra.pool);
+    
+    otra.cabeza = otra.cola = nullptr;
+    otra.longitud = 0;
+    otra.primeraMarca = otra.finMarcas = 0;
+    otra.siguienteMarca = otra.emitidos;
+    otra.progreso.reiniciar();
+    revisarFlujo();
+}
+
+void ListaDeCarga::configurarFlujo(SumideroSalida* destino, long ventana) {
+    sumidero = destino;
+    retener = ventana > 0 ? ventana : 0;
+    
+    if (sumidero && !bloqueFlujo) {
+        bloqueFlujo = new char[TAMANO_BLOQUE_FLUJO];
+    }
+    if (sumidero && longitud > retener) {
+        emitirAntiguos(longitud - retener);
+    }
+}
+
+void ListaDeCarga::emitirAntiguos(long n) {
+    long usados = 0;
+    
+    while (n > 0) {
+        NodoCarga* nodo = cabeza;
+        bloqueFlujo[usados++] = nodo->dato;
+        
+        cabeza = nodo->siguiente;
+        if (cabeza) cabeza->previo = nullptr;
+        pool.liberar(nodo);
+        longitud--;
+        n--;
+        
+        if (usados == TAMANO_BLOQUE_FLUJO || n == 0) {
+            // Si el sumidero falla los datos se pierden, pero la memoria sigue acotada
+            if (!sumidero->escribir(bloqueFlujo, usados)) errorFlujo = true;
+            emitidos += usados;
+            usados = 0;
+        }
+    }
+    if (!cabeza) cola = nullptr;
+    
+    // Descartar las marcas de los nodos devueltos al pool
+    descartarMarcas();
+}
+
+void ListaDeCarga::descartarAntiguos(long n) {
+    if (n > longitud) n = longitud;
+    if (n <= 0) return;
+    
+    for (long i = 0; i < n; i++) {
+        NodoCarga* nodo = cabeza;
+        cabeza = nodo->siguiente;
+        pool.liberar(nodo);
+    }
+    if (cabeza) {
+        cabeza->previo = nullptr;
+    } else {
+        cola = nullptr;
+    }
+    longitud -= n;
+    emitidos += n;
+    descartarMarcas();
+}
+
+bool ListaDeCarga::terminarFlujo() {
+    if (!sumidero) return false;
+    
+    if (longitud > 0) emitirAntiguos(longitud);
+    if (!sumidero->vaciar()) errorFlujo = true;
+    return !errorFlujo;
+}
+
+void ListaDeCarga::configurarProgreso(ModoProgreso modo, int k) {
+    progreso.configurar(modo, k);
+    
+    NodoCarga* actual = cabeza;
+    while (actual) {
+        progreso.registrar(actual->dato);
+        actual = actual->siguiente;
+    }
+}
+
+double ListaDeCarga::getBytesPorFragmento() const {
+    if (longitud == 0) return 0.0;
+    return (double)pool.getBytesReservados() / (double)longitud;
+}
+const NodoCarga* ListaDeCarga::localizar(long posicion) const {
+    if (posicion < emitidos || posicion >= emitidos + longitud) return nullptr;
+    
+    // Las marcas nunca distan más de PASO_INDICE, así que la marca de esta
+    // posición no está antes de 'bajo'; sin uniones de listas es ésa misma.
+    // Desde ahí se avanza al doble y se termina con búsqueda binaria
+    long bajo = primeraMarca;
+    if (bajo < finMarcas && marcas[bajo].posicion <= posicion) {
+        bajo += (posicion - marcas[bajo].posicion) / PASO_INDICE;
+        if (bajo >= finMarcas) bajo = finMarcas - 1;
+    }
+    long alto = bajo + 1;
+    long salto = 1;
+    while (alto < finMarcas && marcas[alto].posicion <= posicion) {
+        bajo = alto;
+        salto *= 2;
+        alto = bajo + salto;
+    }
+    if (alto > finMarcas) alto = finMarcas;
+    
+    // Primera marca después de la posición
+    while (bajo < alto) {
+        long medio = bajo + (alto - bajo) / 2;
+        if (marcas[medio].posicion <= posicion) {
+            bajo = medio + 1;
+        } else {
+            alto = medio;
+        }
+    }
+    
+    // Cada paso es una carga dependiente: se camina desde la marca más
+    // cercana, hacia atrás con 'previo' si la siguiente queda más cerca
+    const NodoCarga* nodo = cabeza;
+    long actual = emitidos;
+    if (bajo > primeraMarca) {
+        nodo = marcas[bajo - 1].nodo;
+        actual = marcas[bajo - 1].posicion;
+    }
+    if (bajo < finMarcas && marcas[bajo].posicion - posicion < posicion - actual) {
+        nodo = marcas[bajo].nodo;
+        actual = marcas[bajo].posicion;
+        while (actual > posicion) {
+            nodo = nodo->previo;
+            actual--;
+        }
+        return nodo;
+    }
+    while (actual < posicion) {
+        nodo = nodo->siguiente;
+        actual++;
+    }
+    return nodo;
+}
+
+bool ListaDeCarga::caracterEn(long posicion, char& dato) const {
+    const NodoCarga* nodo = localizar(posicion);
+    if (!nodo) return false;
+    dato = nodo->dato;
+    return true;
+}
+
+long ListaDeCarga::extraer(long desde, long n, char* destino) const {
+    const NodoCarga* nodo = localizar(desde);
+    long copiados = 0;
+    while (nodo && copiados < n) {
+        destino[copiados++] = nodo->dato;
+        nodo = nodo->siguiente;
+    }
+    return copiados;
+}
+
+long ListaDeCarga::buscar(const char* patron, long longitudPatron, long desde) const {
+    if (desde < emitidos) desde = emitidos;
+    if (longitudPatron <= 0) return (desde <= emitidos + longitud) ? desde : -1;
+    if (longitudPatron > emitidos + longitud - desde) return -1;
+    
+    long* fallo = new long[longitudPatron];
+    construirTablaFallos(patron, longitudPatron, fallo);
+    
+    long encontrada = -1;
+    long posicion = desde;
+    long emparejados = 0;
+    for (const NodoCarga* nodo = localizar(desde); nodo; nodo = nodo->siguiente, posicion++) {
+        while (emparejados > 0 && nodo->dato != patron[emparejados]) {
+            emparejados = fallo[emparejados - 1];
+        }
+        if (nodo->dato == patron[emparejados]) emparejados++;
+        if (emparejados == longitudPatron) {
+            encontrada = posicion - longitudPatron + 1;
+            break;
+        }
+    }
+    
+    delete[] fallo;
+    return encontrada;
+}
@@ -8,6 +8,10 @@
 #ifndef LISTA_DE_CARGA_H
 #define LISTA_DE_CARGA_H
 
+#include "ReporteProgreso.h"
+#include "PoolDeNodos.h"
+#include "SumideroSalida.h"
+
 /**
  * @struct NodoCarga
  * @brief Nodo de la lista doblemente enlazada de carga
@@ -27,11 +31,95 @@ struct NodoCarga {
 /**
  * @class ListaDeCarga
  * @brief Lista doblemente enlazada para almacenar caracteres decodificados en orden
+ *
+ * En modo flujo (configurarFlujo()) la lista sólo retiene los últimos
+ * caracteres: cuando lo acumulado supera la ventana en un bloque completo,
+ * los nodos más antiguos se escriben de una vez en el sumidero y sus
+ * ranuras vuelven al pool, de modo que la memoria queda acotada.
+ *
+ * Sobre la lista se mantiene un índice con un nodo marcado cada
+ * PASO_INDICE inserciones, junto con su posición en el mensaje completo.
+ * Como la lista sólo crece por la cola y sólo se recorta por la cabeza,
+ * las marcas quedan ordenadas y nunca distan más de PASO_INDICE: la marca
+ * de una posición se calcula dividiendo (con una búsqueda acotada donde se
+ * concatenaron listas) y desde ella se camina a lo sumo PASO_INDICE / 2
+ * nodos (caracterEn(), extraer(), buscar()). Las posiciones cuentan
+ * también lo ya emitido en modo flujo.
  */
 class ListaDeCarga {
+public:
+    static const long PASO_INDICE = 32; ///< Nodos entre marcas consecutivas del índice
+    
 private:
+    /**
+     * @struct MarcaIndice
+     * @brief Nodo marcado y su posición en el mensaje completo
+     */
+    struct MarcaIndice {
+        NodoCarga* nodo; ///< Nodo marcado
+        long posicion;   ///< Posición del nodo contando desde el inicio del mensaje
+    };
+    
     NodoCarga* cabeza; ///< Puntero al primer nodo de la lista
     NodoCarga* cola;   ///< Puntero al último nodo de la lista
+    ReporteProgreso progreso; ///< Reporte de progreso alimentado en cada inserción
+    PoolDeNodos<NodoCarga> pool; ///< Bloques de donde salen los nodos de la lista
+    long longitud;     ///< Cantidad de nodos en la lista
+    SumideroSalida* sumidero; ///< Destino en modo flujo (nullptr = retener todo)
+    long retener;      ///< Nodos que se conservan en memoria en modo flujo
+    char* bloqueFlujo; ///< Buffer para escribir los nodos antiguos en bloque
+    long emitidos;     ///< Caracteres ya escritos en el sumidero
+    bool errorFlujo;   ///< Alguna escritura al sumidero falló
+    MarcaIndice* marcas; ///< Marcas del índice; las vigentes van de primeraMarca a finMarcas
+    long capacidadMarcas; ///< Marcas reservadas
+    long primeraMarca; ///< Primera marca cuyo nodo sigue en la lista
+    long finMarcas;    ///< Fin de las marcas usadas
+    long siguienteMarca; ///< Posición a partir de la cual el próximo nodo se marca
+    
+    static const long TAMANO_BLOQUE_FLUJO = 65536; ///< Bytes por escritura al sumidero
+    
+    /**
+     * @brief Escribe y libera los nodos más antiguos
+     * @param n Cantidad de nodos a emitir desde la cabeza
+     */
+    void emitirAntiguos(long n);
+    
+    /**
+     * @brief Quita del índice las marcas de nodos que ya salieron de la lista
+     */
+    void descartarMarcas() {
+        while (primeraMarca < finMarcas && marcas[primeraMarca].posicion < emitidos) {
+            primeraMarca++;
+        }
+    }
+    
+    /**
+     * @brief Agrega una marca al final del índice, reutilizando el espacio
+     *        de las marcas descartadas antes de crecer
+     * @param nodo Nodo a marcar
+     * @param posicion Posición del nodo en el mensaje completo
+     */
+    void agregarMarca(NodoCarga* nodo, long posicion);
+    
+    /**
+     * @brief Marca el nodo recién agregado en la cola si le toca
+     * @param nodo Nodo recién enlazado al final
+     */
+    void indexarCola(NodoCarga* nodo) {
+        long posicion = emitidos + longitud - 1;
+        if (posicion >= siguienteMarca) {
+            agregarMarca(nodo, posicion);
+        }
+    }
+    
+    /**
+     * @brief Emite los nodos que exceden la ventana si ya forman un bloque
+     */
+    void revisarFlujo() {
+        if (sumidero && longitud - retener >= TAMANO_BLOQUE_FLUJO) {
+            emitirAntiguos(longitud - retener);
+        }
+    }
     
 public:
     /**
@@ -41,25 +129,163 @@ public:
     
     /**
      * @brief Destructor que libera la memoria de todos los nodos
+     *
+     * Los nodos viven en los bloques del pool, que se liberan en bloque.
      */
     ~ListaDeCarga();
     
+    ListaDeCarga(const ListaDeCarga&) = delete;
+    ListaDeCarga& operator=(const ListaDeCarga&) = delete;
+    
     /**
      * @brief Inserta un carácter al final de la lista
      * @param dato Carácter a insertar
      */
     void insertarAlFinal(char dato);
     
+    /**
+     * @brief Inserta un bloque de caracteres al final de la lista
+     * @param datos Caracteres a insertar en orden
+     * @param n Cantidad de caracteres
+     */
+    void insertarBloque(const char* datos, long n);
+    
     /**
      * @brief Imprime el mensaje completo almacenado en la lista
      */
     void imprimirMensaje();
     
+    /**
+     * @brief Escribe el mensaje en un flujo usando escrituras por bloques
+     * @param salida Flujo de salida
+     */
+    void escribirMensaje(std::ostream& salida) const;
+    
     /**
      * @brief Obtiene el mensaje actual como cadena de caracteres
      * @return Puntero a cadena con el mensaje (debe ser liberado por el llamador)
      */
     char* obtenerMensaje();
+    
+    /**
+     * @brief Mueve todos los nodos de otra lista al final de ésta
+     * @param otra Lista cuyos nodos se enlazan al final; queda vacía
+     *
+     * El enlace es O(1); sólo si el reporte de progreso está activo se
+     * registran los caracteres movidos.
+     */
+    void concatenar(ListaDeCarga& otra);
+    
+    /**
+     * @brief Activa el modo flujo con memoria acotada
+     * @param destino Sumidero que recibe el mensaje; debe vivir más que la lista
+     *                (nullptr vuelve a retener todo)
+     * @param ventana Caracteres que se conservan en memoria
+     *
+     * Lo que ya excede la ventana se emite de inmediato. Después de esto
+     * escribirMensaje(), obtenerMensaje() y getLongitud() sólo abarcan la
+     * ventana retenida.
+     */
+    void configurarFlujo(SumideroSalida* destino, long ventana);
+    
+    /**
+     * @brief Escribe en el sumidero todo lo retenido y vacía la lista
+     * @return false si alguna escritura al sumidero falló
+     */
+    bool terminarFlujo();
+    
+    /**
+     * @brief Libera los nodos más antiguos sin escribirlos en ningún sumidero
+     * @param n Cantidad de nodos a liberar desde la cabeza (se limita a getLongitud())
+     *
+     * Para quien ya copió esos caracteres con extraer(): las posiciones de
+     * los que quedan no cambian y getEmitidos() avanza como al emitirlos.
+     */
+    void descartarAntiguos(long n);
+    
+    /**
+     * @brief Caracteres escritos en el sumidero o descartados
+     * @return Cantidad de caracteres que ya salieron de la lista, que es
+     *         también la posición en el mensaje del primer carácter retenido
+     */
+    long getEmitidos() const { return emitidos; }
+    
+    /**
+     * @brief Cambia el modo del reporte de progreso
+     * @param modo Modo de reporte a utilizar
+     * @param k Tamaño de la ventana (sólo para PROGRESO_VENTANA)
+     *
+     * Si la lista ya tiene datos se recorre una única vez para reconstruir
+     * el reporte; a partir de ahí se alimenta desde insertarAlFinal().
+     */
+    void configurarProgreso(ModoProgreso modo, int k = 0);
+    
+    /**
+     * @brief Obtiene el reporte de progreso asociado a la lista
+     * @return Referencia al reporte de progreso
+     */
+    const ReporteProgreso& getProgreso() const { return progreso; }
+    
+    /**
+     * @brief Obtiene la cantidad de caracteres almacenados
+     * @return Longitud del mensaje
+     */
+    long getLongitud() const { return longitud; }
+    
+    /**
+     * @brief Ubica el nodo de una posición usando el índice
+     * @param posicion Posición en el mensaje completo
+     * @return Nodo, o nullptr si la posición no está retenida en la lista
+     *
+     * El nodo es válido hasta que la lista descarte su cabeza o se destruya.
+     */
+    const NodoCarga* localizar(long posicion) const;
+    
+    /**
+     * @brief Acceso aleatorio a un carácter del mensaje
+     * @param posicion Posición en el mensaje completo
+     * @param dato Carácter en esa posición
+     * @return false si la posición no está retenida en la lista
+     */
+    bool caracterEn(long posicion, char& dato) const;
+    
+    /**
+     * @brief Copia un tramo del mensaje sin recorrerlo desde la cabeza
+     * @param desde Posición inicial en el mensaje completo
+     * @param n Caracteres a copiar
+     * @param destino Buffer de al menos n bytes (no se agrega '\0')
+     * @return Caracteres copiados; menos de n si el tramo pasa del final y
+     *         0 si 'desde' no está retenida
+     */
+    long extraer(long desde, long n, char* destino) const;
+    
+    /**
+     * @brief Busca un texto en el mensaje sin copiarlo (Knuth-Morris-Pratt)
+     * @param patron Texto a buscar
+     * @param longitudPatron Bytes del texto
+     * @param desde Posición donde empieza la búsqueda
+     * @return Posición de la primera coincidencia, o -1 si no hay
+     *
+     * El recorrido es sólo hacia adelante sobre los nodos, O(n + m), y la
+     * única memoria extra es la tabla de fallos del patrón. Si 'desde'
+     * ya fue emitida, la búsqueda empieza en el primer carácter retenido
+     * (getEmitidos()).
+     */
+    long buscar(const char* patron, long longitudPatron, long desde = 0) const;
+    
+    /**
+     * @brief Bytes reservados para los nodos de la lista y su índice
+     * @return Bytes pedidos al sistema por el pool de nodos y las marcas
+     */
+    size_t getBytesReservados() const {
+        return pool.getBytesReservados() + (size_t)capacidadMarcas * sizeof(MarcaIndice);
+    }
+    
+    /**
+     * @brief Memoria promedio usada por cada fragmento almacenado
+     * @return Bytes reservados divididos entre la longitud (0 si está vacía)
+     */
+    double getBytesPorFragmento() const;
 };
 
 #endif // LISTA_DE_CARGA_H
\ No newline at end of file
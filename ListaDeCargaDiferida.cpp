@@ -0,0 +1,147 @@
+/**
+ * @file ListaDeCargaDiferida.cpp
+ * @brief Implementación de la clase ListaDeCargaDiferida
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "ListaDeCargaDiferida.h"
+#include "NucleoDecodificacion.h"
+#include "RotorDeMapeo.h"
+#include <cstring>
+#include <iostream>
+
+ListaDeCargaDiferida::ListaDeCargaDiferida()
+    : bloques(nullptr), numBloques(0), capacidadBloques(0), escritura(nullptr),
+      finEscritura(nullptr), epocas(nullptr), numEpocas(0), capacidadEpocas(0), longitud(0) {}
+
+ListaDeCargaDiferida::~ListaDeCargaDiferida() {
+    for (long i = 0; i < numBloques; i++) {
+        delete[] bloques[i];
+    }
+    delete[] bloques;
+    delete[] epocas;
+}
+
+void ListaDeCargaDiferida::agregarBloque() {
+    if (numBloques == capacidadBloques) {
+        long nuevaCapacidad = capacidadBloques ? capacidadBloques * 2 : 16;
+        char** nuevos = new char*[nuevaCapacidad];
+        if (bloques) memcpy(nuevos, bloques, numBloques * sizeof(char*));
+        delete[] bloques;
+        bloques = nuevos;
+        capacidadBloques = nuevaCapacidad;
+    }
+    escritura = bloques[numBloques++] = new char[TAMANO_BLOQUE];
+    finEscritura = escritura + TAMANO_BLOQUE;
+}
+
+void ListaDeCargaDiferida::abrirEpoca(int desplazamiento) {
+    if (numEpocas == capacidadEpocas) {
+        long nuevaCapacidad = capacidadEpocas ? capacidadEpocas * 2 : 64;
+        Epoca* nuevas = new Epoca[nuevaCapacidad];
+        if (epocas) memcpy(nuevas, epocas, numEpocas * sizeof(Epoca));
+        delete[] epocas;
+        epocas = nuevas;
+        capacidadEpocas = nuevaCapacidad;
+    }
+    epocas[numEpocas].inicio = longitud;
+    epocas[numEpocas].desplazamiento = desplazamiento;
+    numEpocas++;
+}
+
+void ListaDeCargaDiferida::insertarBloque(const char* crudos, long n, int desplazamiento) {
+    if (n <= 0) return;
+    if (numEpocas == 0 || epocas[numEpocas - 1].desplazamiento != desplazamiento) {
+        abrirEpoca(desplazamiento);
+    }
+    while (n > 0) {
+        if (escritura == finEscritura) agregarBloque();
+        long tramo = finEscritura - escritura;
+        if (tramo > n) tramo = n;
+        memcpy(escritura, crudos, tramo);
+        escritura += tramo;
+        crudos += tramo;
+        longitud += tramo;
+        n -= tramo;
+    }
+}
+
+long ListaDeCargaDiferida::buscarEpoca(long posicion) const {
+    // Última época que empieza en o antes de la posición
+    long bajo = 0, alto = numEpocas;
+    while (alto - bajo > 1) {
+        long medio = bajo + (alto - bajo) / 2;
+        if (epocas[medio].inicio <= posicion) {
+            bajo = medio;
+        } else {
+            alto = medio;
+        }
+    }
+    return bajo;
+}
+
+void ListaDeCargaDiferida::decodificarTramo(long desde, long n, char* destino) const {
+    long e = buscarEpoca(desde);
+    while (n > 0) {
+        long finEpoca = (e + 1 < numEpocas) ? epocas[e + 1].inicio : longitud;
+        long finBloque = (desde | (TAMANO_BLOQUE - 1)) + 1;
+        long tramo = n;
+        if (tramo > finEpoca - desde) tramo = finEpoca - desde;
+        if (tramo > finBloque - desde) tramo = finBloque - desde;
+
+        const char* crudos = bloques[desde >> BITS_BLOQUE] + (desde & (TAMANO_BLOQUE - 1));
+        if (tramo < TRAMO_MINIMO_NUCLEO) {
+            for (long i = 0; i < tramo; i++) {
+                destino[i] = RotorDeMapeo::mapear(crudos[i], epocas[e].desplazamiento);
+            }
+        } else {
+            decodificarBloque(crudos, destino, tramo, epocas[e].desplazamiento);
+        }
+        destino += tramo;
+        desde += tramo;
+        n -= tramo;
+        if (desde == finEpoca) e++;
+    }
+}
+
+long ListaDeCargaDiferida::extraer(long desde, long n, char* destino) const {
+    if (desde < 0 || desde >= longitud || n <= 0) return 0;
+    if (n > longitud - desde) n = longitud - desde;
+    decodificarTramo(desde, n, destino);
+    return n;
+}
+
+bool ListaDeCargaDiferida::caracterEn(long posicion, char& dato) const {
+    return extraer(posicion, 1, &dato) == 1;
+}
+
+void ListaDeCargaDiferida::escribirMensaje(std::ostream& salida) const {
+    char bloque[4096];
+    for (long desde = 0; desde < longitud; desde += (long)sizeof(bloque)) {
+        long n = extraer(desde, (long)sizeof(bloque), bloque);
+        salida.write(bloque, n);
+    }
+}
+
+void ListaDeCargaDiferida::imprimirMensaje() const {
+    escribirMensaje(std::cout);
+    std::cout << std::endl;
+}
+
+char* ListaDeCargaDiferida::obtenerMensaje() const {
+    char* mensaje = new char[longitud + 1];
+    if (longitud > 0) decodificarTramo(0, longitud, mensaje);
+    mensaje[longitud] = '\0';
+    return mensaje;
+}
+
+size_t ListaDeCargaDiferida::getBytesReservados() const {
+    return (size_t)numBloques * TAMANO_BLOQUE + (size_t)capacidadBloques * sizeof(char*) +
+           (size_t)capacidadEpocas * sizeof(Epoca);
+}
+
+double ListaDeCargaDiferida::getBytesPorFragmento() const {
+    if (longitud == 0) return 0.0;
+    return (double)getBytesReservados() / (double)longitud;
+}
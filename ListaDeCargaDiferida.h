@@ -0,0 +1,177 @@
+/**
+ * @file ListaDeCargaDiferida.h
+ * @brief Lista de carga que guarda los fragmentos crudos y decodifica al leer
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef LISTA_DE_CARGA_DIFERIDA_H
+#define LISTA_DE_CARGA_DIFERIDA_H
+
+#include <ostream>
+
+/**
+ * @class ListaDeCargaDiferida
+ * @brief Alternativa a ListaDeCarga que aplaza la sustitución del rotor
+ *
+ * Los caracteres recibidos en las tramas LOAD se guardan tal cual, uno tras
+ * otro, en bloques contiguos de TAMANO_BLOQUE bytes. Cada vez que el rotor
+ * cambia de posición se abre una época: la posición donde empieza y el
+ * desplazamiento vigente. Insertar es copiar un byte; la decodificación
+ * se hace sólo al leer (obtenerMensaje(), imprimirMensaje(), extraer()),
+ * pasando cada tramo de una misma época por el núcleo vectorizado.
+ *
+ * Ocupa un byte por fragmento más una época por cada cambio de rotor que
+ * tenga datos, frente a un nodo doblemente enlazado por fragmento.
+ */
+class ListaDeCargaDiferida {
+public:
+    static const int BITS_BLOQUE = 16;                   ///< log2 del tamaño de bloque
+    static const long TAMANO_BLOQUE = 1L << BITS_BLOQUE; ///< Bytes crudos por bloque
+    static const long TRAMO_MINIMO_NUCLEO = 16;          ///< Tramos más cortos se decodifican sin SIMD
+
+private:
+    /**
+     * @struct Epoca
+     * @brief Tramo de fragmentos recibidos con el rotor en la misma posición
+     */
+    struct Epoca {
+        long inicio;        ///< Posición del primer fragmento de la época
+        int desplazamiento; ///< Desplazamiento del rotor en [0, 26)
+    };
+
+    char** bloques;       ///< Bloques de fragmentos crudos
+    long numBloques;      ///< Bloques reservados
+    long capacidadBloques; ///< Punteros a bloque reservados
+    char* escritura;      ///< Siguiente byte libre del último bloque
+    char* finEscritura;   ///< Fin del último bloque
+    Epoca* epocas;        ///< Épocas en orden de posición
+    long numEpocas;       ///< Épocas usadas
+    long capacidadEpocas; ///< Épocas reservadas
+    long longitud;        ///< Fragmentos almacenados
+
+    /**
+     * @brief Reserva un bloque nuevo y lo deja como destino de escritura
+     */
+    void agregarBloque();
+
+    /**
+     * @brief Abre una época con otro desplazamiento en la posición actual
+     * @param desplazamiento Desplazamiento del rotor en [0, 26)
+     *
+     * Sólo se llama al insertar un fragmento, así que toda época tiene al
+     * menos uno.
+     */
+    void abrirEpoca(int desplazamiento);
+
+    /**
+     * @brief Índice de la época que contiene una posición (búsqueda binaria)
+     * @param posicion Posición en [0, longitud)
+     * @return Índice en epocas
+     */
+    long buscarEpoca(long posicion) const;
+
+    /**
+     * @brief Decodifica un tramo ya validado, época por época y bloque por bloque
+     * @param desde Posición inicial
+     * @param n Fragmentos a decodificar
+     * @param destino Buffer de al menos n bytes
+     */
+    void decodificarTramo(long desde, long n, char* destino) const;
+
+public:
+    /**
+     * @brief Constructor de lista vacía; no reserva memoria
+     */
+    ListaDeCargaDiferida();
+
+    /**
+     * @brief Destructor que libera los bloques y las épocas
+     */
+    ~ListaDeCargaDiferida();
+
+    ListaDeCargaDiferida(const ListaDeCargaDiferida&) = delete;
+    ListaDeCargaDiferida& operator=(const ListaDeCargaDiferida&) = delete;
+
+    /**
+     * @brief Agrega un fragmento crudo sin decodificarlo
+     * @param crudo Carácter tal como llegó en la trama LOAD
+     * @param desplazamiento Desplazamiento del rotor al recibirlo, en [0, 26)
+     */
+    void insertarAlFinal(char crudo, int desplazamiento) {
+        if (numEpocas == 0 || epocas[numEpocas - 1].desplazamiento != desplazamiento) {
+            abrirEpoca(desplazamiento);
+        }
+        if (escritura == finEscritura) agregarBloque();
+        *escritura++ = crudo;
+        longitud++;
+    }
+
+    /**
+     * @brief Agrega varios fragmentos crudos recibidos con el mismo desplazamiento
+     * @param crudos Caracteres tal como llegaron
+     * @param n Cantidad de caracteres
+     * @param desplazamiento Desplazamiento del rotor, en [0, 26)
+     */
+    void insertarBloque(const char* crudos, long n, int desplazamiento);
+
+    /**
+     * @brief Obtiene la cantidad de fragmentos almacenados
+     * @return Longitud del mensaje
+     */
+    long getLongitud() const { return longitud; }
+
+    /**
+     * @brief Cantidad de épocas (tramos con un mismo desplazamiento)
+     * @return Épocas con al menos un fragmento
+     */
+    long getNumEpocas() const { return numEpocas; }
+
+    /**
+     * @brief Decodifica y copia un tramo del mensaje
+     * @param desde Posición inicial
+     * @param n Fragmentos a copiar
+     * @param destino Buffer de al menos n bytes (no se agrega '\\0')
+     * @return Fragmentos copiados; menos de n si el tramo pasa del final
+     */
+    long extraer(long desde, long n, char* destino) const;
+
+    /**
+     * @brief Decodifica un único fragmento
+     * @param posicion Posición en el mensaje
+     * @param dato Carácter decodificado
+     * @return false si la posición está fuera del mensaje
+     */
+    bool caracterEn(long posicion, char& dato) const;
+
+    /**
+     * @brief Decodifica el mensaje completo en un buffer intermedio y lo escribe
+     * @param salida Flujo de salida
+     */
+    void escribirMensaje(std::ostream& salida) const;
+
+    /**
+     * @brief Imprime el mensaje decodificado en la consola
+     */
+    void imprimirMensaje() const;
+
+    /**
+     * @brief Decodifica el mensaje completo en una cadena nueva
+     * @return Cadena terminada en '\\0' (debe ser liberada con delete[])
+     */
+    char* obtenerMensaje() const;
+
+    /**
+     * @brief Bytes reservados para los fragmentos y las épocas
+     * @return Bytes pedidos al sistema
+     */
+    size_t getBytesReservados() const;
+
+    /**
+     * @brief Bytes reservados por fragmento almacenado
+     * @return Promedio de bytes por fragmento (0 si la lista está vacía)
+     */
+    double getBytesPorFragmento() const;
+};
+
+#endif // LISTA_DE_CARGA_DIFERIDA_H
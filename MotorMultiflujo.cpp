@@ -0,0 +1,272 @@
+/**
+ * @file MotorMultiflujo.cpp
+ * @brief Implementación de la clase MotorMultiflujo
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "MotorMultiflujo.h"
+#include "ParserTramas.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @struct TramaDeFlujo
+ * @brief Trama encolada junto con el flujo al que pertenece
+ */
+struct TramaDeFlujo {
+    unsigned long id;  ///< Identificador del flujo
+    TramaValor trama;  ///< Trama a procesar
+};
+
+/**
+ * @brief Tramas que caben en la cola de cada trabajador
+ */
+static const long CAPACIDAD_COLA = 8192;
+
+/**
+ * @brief Mezcla los bits del id para repartir flujos con ids consecutivos
+ * @param id Identificador del flujo
+ * @return Valor mezclado
+ */
+static unsigned long long mezclarId(unsigned long id) {
+    unsigned long long x = id;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief Cubeta de una sesión en la tabla de su trabajador
+ * @param id Identificador del flujo
+ * @param numCubetas Cantidad de cubetas
+ * @return Índice de cubeta
+ *
+ * El trabajador se elige con los bits bajos del id mezclado; la cubeta usa
+ * los altos para que las sesiones de un mismo trabajador no se amontonen en
+ * las cubetas que comparten ese resto.
+ */
+static long cubetaDe(unsigned long id, long numCubetas) {
+    return (long)((mezclarId(id) >> 32) % (unsigned long long)numCubetas);
+}
+
+/**
+ * @struct TrabajadorMultiflujo
+ * @brief Hilo con su propia cola y su propia tabla de sesiones
+ *
+ * Los productores escriben en 'pendientes' bajo el candado; el hilo
+ * intercambia ese buffer por 'enProceso' y lo procesa sin candado.
+ */
+struct TrabajadorMultiflujo {
+    std::thread hilo;                   ///< Hilo del trabajador
+    std::mutex candado;                 ///< Protege la cola y las banderas
+    std::condition_variable hayTrabajo; ///< Avisa al hilo que hay tramas
+    std::condition_variable hayEspacio; ///< Avisa a productores y a esperar()
+    TramaDeFlujo* pendientes;           ///< Tramas recibidas aún no tomadas
+    long numPendientes;                 ///< Cantidad de tramas pendientes
+    TramaDeFlujo* enProceso;            ///< Tramas que el hilo está procesando
+    bool ocupado;                       ///< El hilo está procesando un buffer
+    bool terminar;                      ///< Se pidió terminar el hilo
+
+    SesionFlujo** cubetas;              ///< Tabla hash de sesiones
+    long numCubetas;                    ///< Cantidad de cubetas
+    long numSesiones;                   ///< Sesiones creadas
+
+    TrabajadorMultiflujo()
+        : pendientes(new TramaDeFlujo[CAPACIDAD_COLA]), numPendientes(0),
+          enProceso(new TramaDeFlujo[CAPACIDAD_COLA]), ocupado(false), terminar(false),
+          cubetas(new SesionFlujo*[64]()), numCubetas(64), numSesiones(0) {}
+
+    ~TrabajadorMultiflujo() {
+        for (long i = 0; i < numCubetas; i++) {
+            SesionFlujo* actual = cubetas[i];
+            while (actual) {
+                SesionFlujo* temp = actual;
+                actual = actual->siguiente;
+                delete temp;
+            }
+        }
+        delete[] cubetas;
+        delete[] pendientes;
+        delete[] enProceso;
+    }
+
+    /**
+     * @brief Busca una sesión en la tabla
+     * @param id Identificador del flujo
+     * @return Sesión o nullptr
+     */
+    SesionFlujo* buscar(unsigned long id) const {
+        SesionFlujo* actual = cubetas[cubetaDe(id, numCubetas)];
+        while (actual && actual->id != id) {
+            actual = actual->siguiente;
+        }
+        return actual;
+    }
+
+    /**
+     * @brief Duplica la cantidad de cubetas y redistribuye las sesiones
+     */
+    void crecerTabla() {
+        long nuevoNumCubetas = numCubetas * 2;
+        SesionFlujo** nuevas = new SesionFlujo*[nuevoNumCubetas]();
+        for (long i = 0; i < numCubetas; i++) {
+            SesionFlujo* actual = cubetas[i];
+            while (actual) {
+                SesionFlujo* siguiente = actual->siguiente;
+                long destino = cubetaDe(actual->id, nuevoNumCubetas);
+                actual->siguiente = nuevas[destino];
+                nuevas[destino] = actual;
+                actual = siguiente;
+            }
+        }
+        delete[] cubetas;
+        cubetas = nuevas;
+        numCubetas = nuevoNumCubetas;
+    }
+
+    /**
+     * @brief Obtiene la sesión de un flujo, creándola si no existe
+     * @param id Identificador del flujo
+     * @return Sesión del flujo
+     */
+    SesionFlujo* obtener(unsigned long id) {
+        SesionFlujo* sesion = buscar(id);
+        if (sesion) return sesion;
+
+        if (numSesiones >= numCubetas) crecerTabla();
+        sesion = new SesionFlujo(id);
+        long cubeta = cubetaDe(id, numCubetas);
+        sesion->siguiente = cubetas[cubeta];
+        cubetas[cubeta] = sesion;
+        numSesiones++;
+        return sesion;
+    }
+
+    /**
+     * @brief Bucle del hilo: toma buffers de tramas y los procesa en orden
+     */
+    void ejecutar() {
+        std::unique_lock<std::mutex> bloqueo(candado);
+        while (true) {
+            while (numPendientes == 0 && !terminar) {
+                hayTrabajo.wait(bloqueo);
+            }
+            if (numPendientes == 0 && terminar) break;
+
+            TramaDeFlujo* tomadas = pendientes;
+            long n = numPendientes;
+            pendientes = enProceso;
+            enProceso = tomadas;
+            numPendientes = 0;
+            ocupado = true;
+            bloqueo.unlock();
+            hayEspacio.notify_all();
+
+            // Tramas consecutivas del mismo flujo reutilizan la búsqueda
+            SesionFlujo* sesion = nullptr;
+            for (long i = 0; i < n; i++) {
+                if (!sesion || sesion->id != tomadas[i].id) {
+                    sesion = obtener(tomadas[i].id);
+                }
+                despacharTrama(tomadas[i].trama, &sesion->carga, &sesion->rotor);
+                sesion->tramas++;
+            }
+
+            bloqueo.lock();
+            ocupado = false;
+            hayEspacio.notify_all();
+        }
+    }
+};
+
+MotorMultiflujo::MotorMultiflujo(int hilos) : trabajadores(nullptr), numTrabajadores(hilos), detenido(false) {
+    if (numTrabajadores <= 0) {
+        numTrabajadores = (int)std::thread::hardware_concurrency();
+        if (numTrabajadores <= 0) numTrabajadores = 1;
+    }
+
+    trabajadores = new TrabajadorMultiflujo[numTrabajadores];
+    for (int i = 0; i < numTrabajadores; i++) {
+        TrabajadorMultiflujo* trabajador = &trabajadores[i];
+        trabajador->hilo = std::thread([trabajador]() { trabajador->ejecutar(); });
+    }
+}
+
+MotorMultiflujo::~MotorMultiflujo() {
+    detener();
+    delete[] trabajadores;
+}
+
+TrabajadorMultiflujo& MotorMultiflujo::trabajadorDe(unsigned long id) const {
+    return trabajadores[mezclarId(id) % numTrabajadores];
+}
+
+bool MotorMultiflujo::enviar(unsigned long id, const TramaValor& trama) {
+    return enviarLote(id, &trama, 1);
+}
+
+bool MotorMultiflujo::enviarLote(unsigned long id, const TramaValor* tramas, long n) {
+    TrabajadorMultiflujo& trabajador = trabajadorDe(id);
+    long enviadas = 0;
+
+    while (enviadas < n) {
+        std::unique_lock<std::mutex> bloqueo(trabajador.candado);
+        while (trabajador.numPendientes == CAPACIDAD_COLA && !trabajador.terminar) {
+            trabajador.hayEspacio.wait(bloqueo);
+        }
+        // Tras detener() el hilo ya no toma tramas nuevas
+        if (trabajador.terminar) return false;
+
+        while (enviadas < n && trabajador.numPendientes < CAPACIDAD_COLA) {
+            TramaDeFlujo& destino = trabajador.pendientes[trabajador.numPendientes++];
+            destino.id = id;
+            destino.trama = tramas[enviadas++];
+        }
+
+        bloqueo.unlock();
+        trabajador.hayTrabajo.notify_one();
+    }
+    return true;
+}
+
+void MotorMultiflujo::esperar() {
+    for (int i = 0; i < numTrabajadores; i++) {
+        TrabajadorMultiflujo& trabajador = trabajadores[i];
+        std::unique_lock<std::mutex> bloqueo(trabajador.candado);
+        while (trabajador.numPendientes > 0 || trabajador.ocupado) {
+            trabajador.hayEspacio.wait(bloqueo);
+        }
+    }
+}
+
+void MotorMultiflujo::detener() {
+    if (detenido) return;
+    detenido = true;
+
+    for (int i = 0; i < numTrabajadores; i++) {
+        {
+            std::lock_guard<std::mutex> bloqueo(trabajadores[i].candado);
+            trabajadores[i].terminar = true;
+        }
+        trabajadores[i].hayTrabajo.notify_one();
+        trabajadores[i].hayEspacio.notify_all();
+    }
+    for (int i = 0; i < numTrabajadores; i++) {
+        trabajadores[i].hilo.join();
+    }
+}
+
+const SesionFlujo* MotorMultiflujo::buscarSesion(unsigned long id) const {
+    return trabajadorDe(id).buscar(id);
+}
+
+long MotorMultiflujo::getNumSesiones() const {
+    long total = 0;
+    for (int i = 0; i < numTrabajadores; i++) {
+        total += trabajadores[i].numSesiones;
+    }
+    return total;
+}
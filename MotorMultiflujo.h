@@ -0,0 +1,130 @@
+/**
+ * @file MotorMultiflujo.h
+ * @brief Motor que decodifica muchas sesiones PRT-7 independientes con un grupo de hilos
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef MOTOR_MULTIFLUJO_H
+#define MOTOR_MULTIFLUJO_H
+
+#include "TramaValor.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+/**
+ * @struct SesionFlujo
+ * @brief Estado de decodificación de un flujo identificado por su id
+ */
+struct SesionFlujo {
+    unsigned long id;        ///< Identificador del flujo
+    RotorDeMapeo rotor;      ///< Rotor propio de la sesión
+    ListaDeCarga carga;      ///< Mensaje decodificado de la sesión
+    long tramas;             ///< Tramas procesadas
+    SesionFlujo* siguiente;  ///< Siguiente sesión en la misma cubeta
+
+    /**
+     * @brief Constructor
+     * @param identificador Identificador del flujo
+     */
+    SesionFlujo(unsigned long identificador) : id(identificador), tramas(0), siguiente(nullptr) {
+        carga.configurarProgreso(PROGRESO_APAGADO);
+    }
+};
+
+struct TrabajadorMultiflujo;
+
+/**
+ * @class MotorMultiflujo
+ * @brief Reparte las tramas de muchos flujos en un grupo fijo de hilos
+ *
+ * Cada flujo se asigna siempre al mismo trabajador según su id, así que sus
+ * tramas se procesan en el orden en que se enviaron. Cada trabajador tiene
+ * su propia cola protegida por su propio mutex y su propia tabla de
+ * sesiones, que sólo él modifica: no existe ningún candado global y los
+ * flujos de distintos trabajadores avanzan en paralelo.
+ */
+class MotorMultiflujo {
+private:
+    TrabajadorMultiflujo* trabajadores; ///< Arreglo de trabajadores
+    int numTrabajadores;                ///< Cantidad de trabajadores
+    bool detenido;                      ///< true tras detener()
+
+    /**
+     * @brief Trabajador responsable de un flujo
+     * @param id Identificador del flujo
+     * @return Referencia al trabajador
+     */
+    TrabajadorMultiflujo& trabajadorDe(unsigned long id) const;
+
+public:
+    /**
+     * @brief Constructor que arranca los hilos
+     * @param hilos Número de trabajadores (0 = núcleos disponibles)
+     */
+    MotorMultiflujo(int hilos = 0);
+
+    /**
+     * @brief Destructor que procesa lo pendiente, detiene los hilos y libera las sesiones
+     */
+    ~MotorMultiflujo();
+
+    MotorMultiflujo(const MotorMultiflujo&) = delete;
+    MotorMultiflujo& operator=(const MotorMultiflujo&) = delete;
+
+    /**
+     * @brief Encola una trama para un flujo
+     * @param id Identificador del flujo (la sesión se crea al primer uso)
+     * @param trama Trama a procesar
+     * @return false si el motor ya se detuvo; la trama no se procesa
+     *
+     * Puede llamarse desde varios hilos; el orden se conserva entre las
+     * tramas de un mismo flujo enviadas desde un mismo hilo. Si la cola del
+     * trabajador está llena, el llamador espera.
+     */
+    bool enviar(unsigned long id, const TramaValor& trama);
+
+    /**
+     * @brief Encola varias tramas consecutivas de un flujo tomando el candado una vez
+     * @param id Identificador del flujo
+     * @param tramas Tramas en orden
+     * @param n Cantidad de tramas
+     * @return false si el motor se detuvo antes de encolarlas todas; las
+     *         que no se encolaron no se procesan
+     */
+    bool enviarLote(unsigned long id, const TramaValor* tramas, long n);
+
+    /**
+     * @brief Espera a que todas las tramas encoladas hasta ahora se procesen
+     */
+    void esperar();
+
+    /**
+     * @brief Procesa lo pendiente y detiene los hilos
+     */
+    void detener();
+
+    /**
+     * @brief Busca la sesión de un flujo
+     * @param id Identificador del flujo
+     * @return Sesión o nullptr si no existe
+     *
+     * Sólo debe consultarse después de esperar() o detener(), y sin enviar
+     * tramas del mismo flujo mientras se usa el resultado.
+     */
+    const SesionFlujo* buscarSesion(unsigned long id) const;
+
+    /**
+     * @brief Cantidad total de sesiones creadas
+     * @return Número de sesiones (misma restricción que buscarSesion())
+     */
+    long getNumSesiones() const;
+
+    /**
+     * @brief Cantidad de trabajadores
+     * @return Número de hilos
+     */
+    int getNumTrabajadores() const { return numTrabajadores; }
+};
+
+#endif // MOTOR_MULTIFLUJO_H
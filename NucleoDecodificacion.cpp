@@ -0,0 +1,149 @@
+/**
+ * @file NucleoDecodificacion.cpp
+ * @brief Implementación escalar, SSE2 y AVX2 del núcleo de decodificación
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "NucleoDecodificacion.h"
+#include "RotorDeMapeo.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PRT7_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if defined(PRT7_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define PRT7_AVX2 1
+    #include <immintrin.h>
+#endif
+
+/**
+ * @brief Firma común de todas las implementaciones del núcleo
+ */
+typedef void (*FuncionNucleo)(const char*, char*, long, int);
+
+/**
+ * @brief Versión escalar, usada también para la cola de las versiones SIMD
+ */
+static void decodificarEscalar(const char* entrada, char* salida, long n, int desplazamiento) {
+    for (long i = 0; i < n; i++) {
+        salida[i] = RotorDeMapeo::mapear(entrada[i], desplazamiento);
+    }
+}
+
+#ifdef PRT7_SSE2
+/**
+ * @brief Versión SSE2: 16 caracteres por iteración
+ *
+ * Para cada byte x en A-Z: i = x - 'A' + d; si i > 25 se resta 26 y el
+ * resultado es 'A' + i. Los demás bytes pasan sin cambios mediante una
+ * máscara.
+ */
+static void decodificarSSE2(const char* entrada, char* salida, long n, int desplazamiento) {
+    const __m128i antesDeA = _mm_set1_epi8('A' - 1);
+    const __m128i despuesDeZ = _mm_set1_epi8('Z' + 1);
+    const __m128i letraA = _mm_set1_epi8('A');
+    const __m128i desp = _mm_set1_epi8((char)desplazamiento);
+    const __m128i ultimo = _mm_set1_epi8(RotorDeMapeo::TAMANO_ALFABETO - 1);
+    const __m128i tamano = _mm_set1_epi8(RotorDeMapeo::TAMANO_ALFABETO);
+
+    long i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entrada + i));
+        __m128i esLetra = _mm_and_si128(_mm_cmpgt_epi8(x, antesDeA), _mm_cmplt_epi8(x, despuesDeZ));
+
+        __m128i indice = _mm_add_epi8(_mm_sub_epi8(x, letraA), desp);
+        indice = _mm_sub_epi8(indice, _mm_and_si128(_mm_cmpgt_epi8(indice, ultimo), tamano));
+        __m128i letra = _mm_add_epi8(indice, letraA);
+
+        __m128i resultado = _mm_or_si128(_mm_and_si128(esLetra, letra), _mm_andnot_si128(esLetra, x));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(salida + i), resultado);
+    }
+
+    decodificarEscalar(entrada + i, salida + i, n - i, desplazamiento);
+}
+#endif
+
+#ifdef PRT7_AVX2
+/**
+ * @brief Versión AVX2: misma lógica que SSE2 con 32 caracteres por iteración
+ */
+__attribute__((target("avx2")))
+static void decodificarAVX2(const char* entrada, char* salida, long n, int desplazamiento) {
+    const __m256i antesDeA = _mm256_set1_epi8('A' - 1);
+    const __m256i despuesDeZ = _mm256_set1_epi8('Z' + 1);
+    const __m256i letraA = _mm256_set1_epi8('A');
+    const __m256i desp = _mm256_set1_epi8((char)desplazamiento);
+    const __m256i ultimo = _mm256_set1_epi8(RotorDeMapeo::TAMANO_ALFABETO - 1);
+    const __m256i tamano = _mm256_set1_epi8(RotorDeMapeo::TAMANO_ALFABETO);
+
+    long i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(entrada + i));
+        __m256i esLetra = _mm256_and_si256(_mm256_cmpgt_epi8(x, antesDeA),
+                                           _mm256_cmpgt_epi8(despuesDeZ, x));
+
+        __m256i indice = _mm256_add_epi8(_mm256_sub_epi8(x, letraA), desp);
+        indice = _mm256_sub_epi8(indice, _mm256_and_si256(_mm256_cmpgt_epi8(indice, ultimo), tamano));
+        __m256i letra = _mm256_add_epi8(indice, letraA);
+
+        __m256i resultado = _mm256_blendv_epi8(x, letra, esLetra);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(salida + i), resultado);
+    }
+
+    // La cola usa instrucciones SSE sin codificación VEX: con la mitad alta
+    // de los registros ymm sucia cada llamada pagaría la transición AVX/SSE.
+    // Hace falta explícito porque el compilador convierte esta llamada en un
+    // salto de cola y no agrega vzeroupper antes de un salto
+    _mm256_zeroupper();
+    decodificarSSE2(entrada + i, salida + i, n - i, desplazamiento);
+}
+#endif
+
+/**
+ * @brief Elige la mejor implementación disponible en este procesador
+ * @param nombre Nombre de la implementación elegida
+ * @return Puntero a la implementación
+ */
+static FuncionNucleo elegirNucleo(const char** nombre) {
+#ifdef PRT7_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        *nombre = "avx2";
+        return decodificarAVX2;
+    }
+#endif
+#ifdef PRT7_SSE2
+    *nombre = "sse2";
+    return decodificarSSE2;
+#else
+    *nombre = "escalar";
+    return decodificarEscalar;
+#endif
+}
+
+/**
+ * @brief Implementación elegida, resuelta una sola vez
+ */
+struct NucleoElegido {
+    const char* nombre;   ///< Nombre de la implementación
+    FuncionNucleo funcion; ///< Puntero a la implementación
+
+    NucleoElegido() : nombre(nullptr), funcion(elegirNucleo(&nombre)) {}
+};
+
+/**
+ * @brief Obtiene la implementación elegida (inicialización segura entre hilos)
+ */
+static const NucleoElegido& nucleo() {
+    static const NucleoElegido elegido;
+    return elegido;
+}
+
+void decodificarBloque(const char* entrada, char* salida, long n, int desplazamiento) {
+    nucleo().funcion(entrada, salida, n, desplazamiento);
+}
+
+const char* nombreNucleoDecodificacion() {
+    return nucleo().nombre;
+}
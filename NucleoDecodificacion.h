@@ -0,0 +1,34 @@
+/**
+ * @file NucleoDecodificacion.h
+ * @brief Núcleo vectorizado para decodificar rachas de tramas LOAD
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef NUCLEO_DECODIFICACION_H
+#define NUCLEO_DECODIFICACION_H
+
+/**
+ * @brief Decodifica un bloque de caracteres con una rotación fija
+ * @param entrada Caracteres recibidos en tramas LOAD consecutivas
+ * @param salida Destino de los caracteres decodificados (puede ser igual a entrada)
+ * @param n Cantidad de caracteres
+ * @param desplazamiento Posición de la cabeza del rotor en [0, 26)
+ *
+ * Entre dos tramas MAP todas las tramas LOAD usan el mismo desplazamiento,
+ * así que la racha completa es una sustitución byte a byte: A-Z avanza
+ * (indice + desplazamiento) mod 26 posiciones y el resto de bytes no cambia. El resultado es idéntico a llamar
+ * RotorDeMapeo::mapear() para cada carácter.
+ *
+ * En x86 se usa AVX2 si el procesador lo soporta (detectado en tiempo de
+ * ejecución) o SSE2; en otras arquitecturas se usa la versión escalar.
+ */
+void decodificarBloque(const char* entrada, char* salida, long n, int desplazamiento);
+
+/**
+ * @brief Nombre de la implementación elegida para este procesador
+ * @return "avx2", "sse2" o "escalar"
+ */
+const char* nombreNucleoDecodificacion();
+
+#endif // NUCLEO_DECODIFICACION_H
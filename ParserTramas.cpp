@@ -0,0 +1,345 @@
+/**
+ * @file ParserTramas.cpp
+ * @brief Implementación del parseo y despacho de tramas
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "ParserTramas.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "Instrumentacion.h"
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+    #define PRT7_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+/**
+ * @brief Clases de byte que distingue el autómata de líneas
+ */
+enum ClaseByte {
+    CLASE_L,      ///< 'L'
+    CLASE_M,      ///< 'M'
+    CLASE_COMA,   ///< ','
+    CLASE_SIGNO,  ///< '+' o '-'
+    CLASE_DIGITO, ///< '0'-'9'
+    CLASE_BLANCO, ///< ' ' o '\t' antes del número
+    CLASE_NULO,   ///< '\0', que no puede ser el dato de una trama LOAD
+    CLASE_OTRO,   ///< Cualquier otro byte
+    NUM_CLASES
+};
+
+/**
+ * @brief Estados del autómata; a partir de ESTADO_L_DATO son absorbentes
+ */
+enum EstadoLinea {
+    ESTADO_INICIO,
+    ESTADO_L,        ///< Leyó "L"
+    ESTADO_L_COMA,   ///< Leyó "L,"
+    ESTADO_M,        ///< Leyó "M"
+    ESTADO_M_COMA,   ///< Leyó "M," y quizá blancos
+    ESTADO_M_SIGNO,  ///< Leyó el signo de la rotación
+    ESTADO_M_DIGITOS,///< Dentro de los dígitos de la rotación (o del rotor)
+    ESTADO_N_COMA,   ///< Leyó "M,R," y quizá blancos: sigue la rotación
+    ESTADO_N_SIGNO,  ///< Leyó el signo de la rotación tras el rotor
+    ESTADO_N_DIGITOS,///< Dentro de los dígitos de la rotación tras el rotor
+    ESTADO_L_DATO,   ///< Trama LOAD completa; el resto de la línea se ignora
+    ESTADO_M_FIN,    ///< Rotación terminada; el resto de la línea se ignora
+    ESTADO_ERROR,    ///< La línea no es una trama
+    NUM_ESTADOS
+};
+
+/**
+ * @brief Transiciones [estado][clase]; reproduce "L,X", "L,Space" y la
+ *        lectura tipo atoi de "M,N"; una coma justo después de los dígitos
+ *        convierte el primer número en el rotor de "M,R,N"
+ */
+static const unsigned char TRANSICION_CLASES[NUM_ESTADOS][NUM_CLASES] = {
+    //               L               M               COMA            SIGNO           DIGITO            BLANCO          NULO            OTRO
+    /* INICIO   */ { ESTADO_L,       ESTADO_M,       ESTADO_ERROR,   ESTADO_ERROR,   ESTADO_ERROR,     ESTADO_ERROR,   ESTADO_ERROR,   ESTADO_ERROR },
+    /* L        */ { ESTADO_ERROR,   ESTADO_ERROR,   ESTADO_L_COMA,  ESTADO_ERROR,   ESTADO_ERROR,     ESTADO_ERROR,   ESTADO_ERROR,   ESTADO_ERROR },
+    /* L_COMA   */ { ESTADO_L_DATO,  ESTADO_L_DATO,  ESTADO_L_DATO,  ESTADO_L_DATO,  ESTADO_L_DATO,    ESTADO_L_DATO,  ESTADO_ERROR,   ESTADO_L_DATO },
+    /* M        */ { ESTADO_ERROR,   ESTADO_ERROR,   ESTADO_M_COMA,  ESTADO_ERROR,   ESTADO_ERROR,     ESTADO_ERROR,   ESTADO_ERROR,   ESTADO_ERROR },
+    /* M_COMA   */ { ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_SIGNO, ESTADO_M_DIGITOS, ESTADO_M_COMA,  ESTADO_M_FIN,   ESTADO_M_FIN },
+    /* M_SIGNO  */ { ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_DIGITOS, ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN },
+    /* M_DIGITOS*/ { ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_N_COMA,  ESTADO_M_FIN,   ESTADO_M_DIGITOS, ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN },
+    /* N_COMA   */ { ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_N_SIGNO, ESTADO_N_DIGITOS, ESTADO_N_COMA,  ESTADO_M_FIN,   ESTADO_M_FIN },
+    /* N_SIGNO  */ { ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_N_DIGITOS, ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN },
+    /* N_DIGITOS*/ { ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_N_DIGITOS, ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN },
+    /* L_DATO   */ { ESTADO_L_DATO,  ESTADO_L_DATO,  ESTADO_L_DATO,  ESTADO_L_DATO,  ESTADO_L_DATO,    ESTADO_L_DATO,  ESTADO_L_DATO,  ESTADO_L_DATO },
+    /* M_FIN    */ { ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN,     ESTADO_M_FIN,   ESTADO_M_FIN,   ESTADO_M_FIN },
+    /* ERROR    */ { ESTADO_ERROR,   ESTADO_ERROR,   ESTADO_ERROR,   ESTADO_ERROR,   ESTADO_ERROR,     ESTADO_ERROR,   ESTADO_ERROR,   ESTADO_ERROR },
+};
+
+/**
+ * @brief Autómata expandido a [estado][byte] para no clasificar cada byte
+ */
+struct TablaAutomata {
+    unsigned char transicion[NUM_ESTADOS][256]; ///< Siguiente estado por byte
+
+    TablaAutomata() {
+        for (int c = 0; c < 256; c++) {
+            int clase = CLASE_OTRO;
+            if (c >= '0' && c <= '9') clase = CLASE_DIGITO;
+            else if (c == 'L') clase = CLASE_L;
+            else if (c == 'M') clase = CLASE_M;
+            else if (c == ',') clase = CLASE_COMA;
+            else if (c == '+' || c == '-') clase = CLASE_SIGNO;
+            else if (c == ' ' || c == '\t') clase = CLASE_BLANCO;
+            else if (c == 0) clase = CLASE_NULO;
+
+            for (int estado = 0; estado < NUM_ESTADOS; estado++) {
+                transicion[estado][c] = TRANSICION_CLASES[estado][clase];
+            }
+        }
+    }
+};
+
+static const TablaAutomata AUTOMATA;
+
+/**
+ * @brief Mayor índice de rotor que cabe en TramaValor::rotor
+ */
+static const long long MAX_ROTOR_TRAMA = 255;
+
+/**
+ * @brief Recorre una línea con el autómata
+ * @param linea Inicio de la línea
+ * @param longitud Bytes de la línea, sin '\r' ni '\n'
+ * @param trama Trama resultante
+ * @return true si la línea es una trama válida
+ *
+ * La rotación se acumula en los dígitos y se satura al rango de int, igual
+ * que el atoi original pero sin depender de un '\0' final.
+ */
+static inline bool parsearLinea(const char* linea, long longitud, TramaValor& trama) {
+    trama.tipo = TRAMA_INVALIDA;
+    if (longitud < 2) return false;
+
+    // El prefijo "L," o "M," decide el tipo con dos consultas a la tabla
+    int estado = AUTOMATA.transicion[ESTADO_INICIO][(unsigned char)linea[0]];
+    estado = AUTOMATA.transicion[estado][(unsigned char)linea[1]];
+
+    if (estado == ESTADO_L_COMA) {
+        if (longitud < 3) return false;
+        estado = AUTOMATA.transicion[estado][(unsigned char)linea[2]];
+        if (estado != ESTADO_L_DATO) return false;
+
+        trama.tipo = TRAMA_LOAD;
+        trama.caracter = linea[2];
+        if (longitud >= 7 && memcmp(linea + 2, "Space", 5) == 0) {
+            trama.caracter = ' ';
+        }
+        return true;
+    }
+    if (estado != ESTADO_M_COMA) return false;
+
+    // Rotación: el autómata recorre blancos, signo y dígitos hasta M_FIN
+    bool negativo = false;
+    long long valor = 0;
+    long long rotor = 0;
+    for (long i = 2; i < longitud && estado != ESTADO_M_FIN; i++) {
+        unsigned char byte = (unsigned char)linea[i];
+        int anterior = estado;
+        estado = AUTOMATA.transicion[estado][byte];
+        if (estado == ESTADO_M_DIGITOS || estado == ESTADO_N_DIGITOS) {
+            if (valor <= INT_MAX) valor = valor * 10 + (byte - '0');
+        } else if (estado == ESTADO_M_SIGNO || estado == ESTADO_N_SIGNO) {
+            negativo = (byte == '-');
+        } else if (estado == ESTADO_N_COMA && anterior == ESTADO_M_DIGITOS) {
+            // El número leído era el rotor; no puede ser negativo
+            if (negativo || valor > MAX_ROTOR_TRAMA) return false;
+            rotor = valor;
+            valor = 0;
+        }
+    }
+
+    if (negativo) valor = -valor;
+    if (valor > INT_MAX) valor = INT_MAX;
+    if (valor < INT_MIN) valor = INT_MIN;
+    trama.tipo = TRAMA_MAP;
+    trama.rotor = (unsigned char)rotor;
+    trama.rotacion = (int)valor;
+    return true;
+}
+
+/**
+ * @brief Parsea una línea del bloque y la agrega al arreglo si es válida
+ */
+static inline void agregarLinea(const char* linea, long longitud, TramaValor* tramas,
+                                long& enTramas, long& malformadas) {
+    if (longitud > 0 && linea[longitud - 1] == '\r') longitud--;
+    if (longitud == 0) return;
+
+    if (parsearLinea(linea, longitud, tramas[enTramas])) {
+        enTramas++;
+    } else {
+        malformadas++;
+        PRT7_CONTAR(CONTADOR_MALFORMADAS, 1);
+    }
+}
+
+bool parsearTramaValor(const char* linea, TramaValor& trama) {
+    if (!linea) {
+        trama.tipo = TRAMA_INVALIDA;
+        return false;
+    }
+    return parsearTramaValor(linea, (long)strlen(linea), trama);
+}
+
+bool parsearTramaValor(const char* linea, long longitud, TramaValor& trama) {
+    if (!linea) {
+        trama.tipo = TRAMA_INVALIDA;
+        return false;
+    }
+    return parsearLinea(linea, longitud, trama);
+}
+
+long parsearBloqueTramas(const char* datos, long n, TramaValor* tramas, long maxTramas,
+                         long& consumidos, long& malformadas) {
+    long enTramas = 0;
+    long inicioLinea = 0;
+    long i = 0;
+
+#ifdef PRT7_SSE2
+    // Los saltos de 16 bytes se ubican con una sola comparación y se
+    // recorren bit a bit, sin una llamada a memchr por línea
+    const __m128i salto = _mm_set1_epi8('\n');
+    for (; i + 16 <= n && enTramas < maxTramas; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(datos + i));
+        unsigned mascara = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, salto));
+        while (mascara && enTramas < maxTramas) {
+            long posSalto = i + __builtin_ctz(mascara);
+            mascara &= mascara - 1;
+            agregarLinea(datos + inicioLinea, posSalto - inicioLinea, tramas, enTramas, malformadas);
+            inicioLinea = posSalto + 1;
+        }
+    }
+#endif
+
+    while (i < n && enTramas < maxTramas) {
+        const char* salto = static_cast<const char*>(memchr(datos + i, '\n', n - i));
+        if (!salto) break;
+        long posSalto = salto - datos;
+        agregarLinea(datos + inicioLinea, posSalto - inicioLinea, tramas, enTramas, malformadas);
+        inicioLinea = i = posSalto + 1;
+    }
+
+    consumidos = inicioLinea;
+    return enTramas;
+}
+
+int formatearTramaTexto(const TramaValor& trama, char* destino) {
+    if (trama.tipo == TRAMA_LOAD) {
+        if (trama.caracter == ' ') {
+            memcpy(destino, "L,Space\r\n", 9);
+            return 9;
+        }
+        destino[0] = 'L';
+        destino[1] = ',';
+        destino[2] = trama.caracter;
+        destino[3] = '\r';
+        destino[4] = '\n';
+        return 5;
+    }
+    if (trama.tipo == TRAMA_MAP) {
+        if (trama.rotor != 0) {
+            return snprintf(destino, PRT7_MAX_BYTES_LINEA, "M,%d,%d\r\n", trama.rotor, trama.rotacion);
+        }
+        return snprintf(destino, PRT7_MAX_BYTES_LINEA, "M,%d\r\n", trama.rotacion);
+    }
+    return 0;
+}
+
+TramaBase* parsearTrama(char* linea) {
+    TramaValor trama;
+    if (!parsearTramaValor(linea, trama)) return nullptr;
+    if (trama.tipo == TRAMA_MAP && trama.rotor != 0) return nullptr; // TramaMap mueve un solo rotor
+    
+    if (trama.tipo == TRAMA_LOAD) {
+        return new TramaLoad(trama.caracter);
+    }
+    return new TramaMap(trama.rotacion);
+}
+
+void despacharTrama(const TramaValor& trama, ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    PRT7_MARCA(inicio);
+    switch (trama.tipo) {
+        case TRAMA_LOAD:
+            TramaLoad::procesarCaracter(trama.caracter, carga, rotor);
+            break;
+        case TRAMA_MAP:
+            // Con un solo rotor, los MAP dirigidos a otros rotores no aplican
+            if (trama.rotor == 0) TramaMap::procesarRotacion(trama.rotacion, carga, rotor);
+            break;
+        default:
+            return;
+    }
+    PRT7_MEDIR(ETAPA_PROCESAR, inicio);
+    PRT7_CONTAR(CONTADOR_TRAMAS, 1);
+}
+
+void despacharTrama(const TramaValor& trama, ListaDeCarga* carga, RotorImprimible* rotor) {
+    PRT7_MARCA(inicio);
+    switch (trama.tipo) {
+        case TRAMA_LOAD: {
+            char decodificado = rotor->getMapeo(trama.caracter);
+            carga->insertarAlFinal(decodificado);
+            TramaLoad::imprimirProgreso(trama.caracter, decodificado, carga->getProgreso());
+            break;
+        }
+        case TRAMA_MAP:
+            if (trama.rotor != 0) break;
+            rotor->rotar(trama.rotacion);
+            if (carga->getProgreso().getModo() != PROGRESO_APAGADO) {
+                TramaMap::imprimirProgreso(trama.rotacion);
+            }
+            break;
+        default:
+            return;
+    }
+    PRT7_MEDIR(ETAPA_PROCESAR, inicio);
+    PRT7_CONTAR(CONTADOR_TRAMAS, 1);
+}
+
+void despacharTramaCascada(const TramaValor& trama, ListaDeCarga* carga, CascadaRotores* cascada) {
+    PRT7_MARCA(inicio);
+    switch (trama.tipo) {
+        case TRAMA_LOAD: {
+            char decodificado = cascada->getMapeo(trama.caracter);
+            carga->insertarAlFinal(decodificado);
+            TramaLoad::imprimirProgreso(trama.caracter, decodificado, carga->getProgreso());
+            break;
+        }
+        case TRAMA_MAP:
+            if (cascada->rotar(trama.rotor, trama.rotacion) &&
+                carga->getProgreso().getModo() != PROGRESO_APAGADO) {
+                TramaMap::imprimirProgreso(trama.rotacion, trama.rotor);
+            }
+            break;
+        default:
+            return;
+    }
+    PRT7_MEDIR(ETAPA_PROCESAR, inicio);
+    PRT7_CONTAR(CONTADOR_TRAMAS, 1);
+}
+
+void despacharTramaDiferida(const TramaValor& trama, ListaDeCargaDiferida* carga, RotorDeMapeo* rotor) {
+    PRT7_MARCA(inicio);
+    switch (trama.tipo) {
+        case TRAMA_LOAD:
+            carga->insertarAlFinal(trama.caracter, rotor->getDesplazamiento());
+            break;
+        case TRAMA_MAP:
+            if (trama.rotor == 0) rotor->rotar(trama.rotacion);
+            break;
+        default:
+            return;
+    }
+    PRT7_MEDIR(ETAPA_PROCESAR, inicio);
+    PRT7_CONTAR(CONTADOR_TRAMAS, 1);
+}
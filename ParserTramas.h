@@ -0,0 +1,115 @@
+/**
+ * @file ParserTramas.h
+ * @brief Parseo de líneas PRT-7 y despacho de tramas sin memoria dinámica
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef PARSER_TRAMAS_H
+#define PARSER_TRAMAS_H
+
+#include "TramaBase.h"
+#include "TramaValor.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "CascadaRotores.h"
+#include "ListaDeCargaDiferida.h"
+
+const int PRT7_MAX_BYTES_LINEA = 24; ///< Longitud máxima de una línea de formatearTramaTexto()
+
+/**
+ * @brief Parsea una línea en una trama por valor
+ * @param linea Línea terminada en '\\0' (ej. "L,A", "L,Space", "M,-2", "M,1,-2")
+ * @param trama Trama resultante; su tipo es TRAMA_INVALIDA si hay error
+ * @return true si la línea es una trama válida
+ */
+bool parsearTramaValor(const char* linea, TramaValor& trama);
+
+/**
+ * @brief Parsea una línea delimitada por longitud, sin requerir '\0'
+ * @param linea Inicio de la línea (ej. dentro de un archivo mapeado)
+ * @param longitud Cantidad de bytes de la línea, sin el salto de línea
+ * @param trama Trama resultante; su tipo es TRAMA_INVALIDA si hay error
+ * @return true si la línea es una trama válida
+ */
+bool parsearTramaValor(const char* linea, long longitud, TramaValor& trama);
+
+/**
+ * @brief Parsea de una vez todas las líneas completas de un bloque de bytes
+ * @param datos Bytes recibidos; pueden terminar a mitad de una línea
+ * @param n Cantidad de bytes
+ * @param tramas Arreglo donde se escriben las tramas válidas
+ * @param maxTramas Capacidad del arreglo
+ * @param consumidos Bytes procesados, hasta justo después del último '\n'
+ *        usado; lo que sigue es una línea incompleta (o no cupo en el
+ *        arreglo) y debe volver a entregarse junto con la siguiente lectura
+ * @param malformadas Se incrementa por cada línea no vacía que no es trama
+ * @return Tramas escritas en el arreglo
+ *
+ * Los saltos de línea se buscan en un solo recorrido (SSE2 si está
+ * disponible, memchr si no) y cada línea pasa por el mismo autómata por
+ * tablas que parsearTramaValor().
+ */
+long parsearBloqueTramas(const char* datos, long n, TramaValor* tramas, long maxTramas,
+                         long& consumidos, long& malformadas);
+
+/**
+ * @brief Escribe una trama en formato de texto, inverso de parsearTramaValor()
+ * @param trama Trama LOAD o MAP
+ * @param destino Buffer de al menos PRT7_MAX_BYTES_LINEA bytes
+ * @return Bytes escritos, incluyendo el "\\r\\n" final (0 si la trama no es válida)
+ */
+int formatearTramaTexto(const TramaValor& trama, char* destino);
+
+/**
+ * @brief Parsea una línea y crea la trama correspondiente en el heap
+ * @param linea Línea leída del puerto serial
+ * @return Puntero a la trama creada o nullptr si hay error (también para un
+ *         MAP a un rotor distinto del 0, que TramaMap no puede representar)
+ *
+ * Se conserva para extender el protocolo con nuevas clases derivadas de
+ * TramaBase; el bucle principal usa parsearTramaValor() y despacharTrama().
+ */
+TramaBase* parsearTrama(char* linea);
+
+/**
+ * @brief Procesa una trama por valor sin crear objetos ni llamadas virtuales
+ * @param trama Trama a procesar
+ * @param carga Lista de carga donde se insertan los datos decodificados
+ * @param rotor Rotor de mapeo usado para la decodificación
+ *
+ * Los MAP dirigidos a un rotor distinto del 0 ("M,R,N") no se aplican: para
+ * ellos hace falta despacharTramaCascada(). LectorTramas ya los descarta y
+ * los cuenta como mal formados antes de llegar aquí.
+ */
+void despacharTrama(const TramaValor& trama, ListaDeCarga* carga, RotorDeMapeo* rotor);
+
+/**
+ * @brief Procesa una trama con el rotor del ASCII imprimible (ALFABETO_IMPRIMIBLE)
+ * @param trama Trama a procesar
+ * @param carga Lista de carga donde se insertan los datos decodificados
+ * @param rotor Rotor imprimible; minúsculas, dígitos y signos también rotan
+ *
+ * Igual que con RotorDeMapeo, los MAP a un rotor distinto del 0 no se aplican.
+ */
+void despacharTrama(const TramaValor& trama, ListaDeCarga* carga, RotorImprimible* rotor);
+
+/**
+ * @brief Procesa una trama con una cadena de rotores
+ * @param trama Trama a procesar; los MAP mueven el rotor trama.rotor
+ * @param carga Lista de carga donde se insertan los datos decodificados
+ * @param cascada Cadena de rotores; los MAP a rotores fuera de ella se ignoran
+ */
+void despacharTramaCascada(const TramaValor& trama, ListaDeCarga* carga, CascadaRotores* cascada);
+
+/**
+ * @brief Procesa una trama guardando el fragmento crudo para decodificarlo al leer
+ * @param trama Trama a procesar
+ * @param carga Lista diferida donde se agregan los fragmentos sin decodificar
+ * @param rotor Rotor de mapeo; sólo se usa su desplazamiento
+ *
+ * No muestra progreso: eso obligaría a decodificar cada fragmento al llegar.
+ */
+void despacharTramaDiferida(const TramaValor& trama, ListaDeCargaDiferida* carga, RotorDeMapeo* rotor);
+
+#endif // PARSER_TRAMAS_H
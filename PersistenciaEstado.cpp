@@ -0,0 +1,249 @@
+/**
+ * @file PersistenciaEstado.cpp
+ * @brief Implementación de la clase PersistenciaEstado
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "PersistenciaEstado.h"
+#include "ProtocoloBinario.h"
+#include "ParserTramas.h"
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * @brief Marcas de los archivos de estado
+ */
+static const char MAGIA_ESTADO[8] = { 'P', 'R', 'T', '7', 'E', 'S', 'T', '1' };
+static const char MAGIA_DIARIO[8] = { 'P', 'R', 'T', '7', 'D', 'I', 'A', '1' };
+static const char MAGIA_FIN[4] = { 'F', 'I', 'N', '7' };
+
+/**
+ * @brief Concatena una ruta base y una extensión en memoria nueva
+ * @param base Ruta base
+ * @param extension Extensión a agregar
+ * @return Cadena reservada con new[]
+ */
+static char* unirRuta(const char* base, const char* extension) {
+    size_t n = strlen(base);
+    size_t m = strlen(extension);
+    char* ruta = new char[n + m + 1];
+    memcpy(ruta, base, n);
+    memcpy(ruta + n, extension, m + 1);
+    return ruta;
+}
+
+/**
+ * @brief Fuerza al disco el contenido de un archivo ya cerrado
+ * @param ruta Ruta del archivo
+ */
+static void sincronizarArchivo(const char* ruta) {
+#ifndef _WIN32
+    int fd = open(ruta, O_RDONLY);
+    if (fd != -1) {
+        fsync(fd);
+        close(fd);
+    }
+#else
+    (void)ruta;
+#endif
+}
+
+/**
+ * @brief Reemplaza un archivo por otro de forma atómica
+ * @param origen Archivo nuevo
+ * @param destino Archivo a reemplazar
+ * @return false si falló
+ */
+static bool reemplazarArchivo(const char* origen, const char* destino) {
+#ifdef _WIN32
+    return MoveFileExA(origen, destino, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(origen, destino) == 0;
+#endif
+}
+
+PersistenciaEstado::PersistenciaEstado()
+    : rutaEstado(nullptr), rutaTemporal(nullptr), rutaDiario(nullptr), diario(nullptr),
+      enBuffer(0), tramasAplicadas(0), tramasEnDiario(0), tramasReaplicadas(0), huboHueco(false) {}
+
+PersistenciaEstado::~PersistenciaEstado() {
+    vaciar();
+    cerrar();
+}
+
+void PersistenciaEstado::cerrar() {
+    if (diario) fclose(diario);
+    diario = nullptr;
+    delete[] rutaEstado;
+    delete[] rutaTemporal;
+    delete[] rutaDiario;
+    rutaEstado = rutaTemporal = rutaDiario = nullptr;
+}
+
+bool PersistenciaEstado::abrir(const char* rutaBase, ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    cerrar();
+    rutaEstado = unirRuta(rutaBase, ".estado");
+    rutaTemporal = unirRuta(rutaBase, ".estado.tmp");
+    rutaDiario = unirRuta(rutaBase, ".diario");
+    enBuffer = 0;
+    tramasAplicadas = 0;
+    tramasReaplicadas = 0;
+    huboHueco = false;
+    
+    // La reaplicación no debe mostrar progreso por cada trama recuperada
+    carga->configurarProgreso(PROGRESO_APAGADO);
+    cargarInstantanea(carga, rotor);
+    reaplicarDiario(carga, rotor);
+    
+    return guardarInstantanea(*carga, *rotor);
+}
+
+bool PersistenciaEstado::cargarInstantanea(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    std::ifstream entrada(rutaEstado, std::ios::binary);
+    if (!entrada) return false;
+    
+    char magia[8];
+    int desplazamiento;
+    long long tramas;
+    long long longitud;
+    entrada.read(magia, sizeof(magia));
+    entrada.read(reinterpret_cast<char*>(&desplazamiento), sizeof(desplazamiento));
+    entrada.read(reinterpret_cast<char*>(&tramas), sizeof(tramas));
+    entrada.read(reinterpret_cast<char*>(&longitud), sizeof(longitud));
+    if (!entrada || memcmp(magia, MAGIA_ESTADO, sizeof(magia)) != 0 || longitud < 0 ||
+        desplazamiento < 0 || desplazamiento >= RotorDeMapeo::TAMANO_ALFABETO) {
+        return false;
+    }
+    
+    // Leer el mensaje aparte para no dejar la lista a medias si está truncado
+    ListaDeCarga mensaje;
+    mensaje.configurarProgreso(PROGRESO_APAGADO);
+    char bloque[65536];
+    long long restantes = longitud;
+    while (restantes > 0) {
+        long n = restantes < (long long)sizeof(bloque) ? (long)restantes : (long)sizeof(bloque);
+        if (!entrada.read(bloque, n)) return false;
+        mensaje.insertarBloque(bloque, n);
+        restantes -= n;
+    }
+    
+    char fin[4];
+    if (!entrada.read(fin, sizeof(fin)) || memcmp(fin, MAGIA_FIN, sizeof(fin)) != 0) {
+        return false;
+    }
+    
+    carga->concatenar(mensaje);
+    rotor->rotar(desplazamiento - rotor->getDesplazamiento());
+    tramasAplicadas = tramas;
+    return true;
+}
+
+void PersistenciaEstado::reaplicarDiario(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    FILE* archivo = fopen(rutaDiario, "rb");
+    if (!archivo) return;
+    
+    char magia[8];
+    long long base;
+    if (fread(magia, 1, sizeof(magia), archivo) != sizeof(magia) ||
+        memcmp(magia, MAGIA_DIARIO, sizeof(magia)) != 0 ||
+        fread(&base, sizeof(base), 1, archivo) != 1 || base < 0) {
+        fclose(archivo);
+        return;
+    }
+    
+    // Las tramas anteriores a la instantánea ya están incluidas en ella
+    if (base > tramasAplicadas) huboHueco = true;
+    long long numero = base;
+    
+    DecodificadorBinario decodificador;
+    TramaValor trama;
+    unsigned char bloque[65536];
+    size_t leidos;
+    while ((leidos = fread(bloque, 1, sizeof(bloque), archivo)) > 0) {
+        for (size_t i = 0; i < leidos; i++) {
+            if (!decodificador.empujar(bloque[i], trama)) continue;
+            if (numero >= tramasAplicadas) {
+                despacharTrama(trama, carga, rotor);
+                tramasReaplicadas++;
+                tramasAplicadas = numero + 1;
+            }
+            numero++;
+        }
+    }
+    // Una trama cortada al final del diario se descarta: nunca llegó a aplicarse
+    fclose(archivo);
+}
+
+bool PersistenciaEstado::iniciarDiario() {
+    if (diario) fclose(diario);
+    diario = fopen(rutaDiario, "wb");
+    if (!diario) return false;
+    
+    long long base = tramasAplicadas;
+    if (fwrite(MAGIA_DIARIO, 1, sizeof(MAGIA_DIARIO), diario) != sizeof(MAGIA_DIARIO) ||
+        fwrite(&base, sizeof(base), 1, diario) != 1 || fflush(diario) != 0) {
+        return false;
+    }
+    tramasEnDiario = 0;
+    return true;
+}
+
+bool PersistenciaEstado::guardarInstantanea(const ListaDeCarga& carga, const RotorDeMapeo& rotor) {
+    if (!rutaEstado || !vaciar()) return false;
+    
+    {
+        std::ofstream salida(rutaTemporal, std::ios::binary | std::ios::trunc);
+        if (!salida) return false;
+        
+        int desplazamiento = rotor.getDesplazamiento();
+        long long tramas = tramasAplicadas;
+        long long longitud = carga.getLongitud();
+        salida.write(MAGIA_ESTADO, sizeof(MAGIA_ESTADO));
+        salida.write(reinterpret_cast<const char*>(&desplazamiento), sizeof(desplazamiento));
+        salida.write(reinterpret_cast<const char*>(&tramas), sizeof(tramas));
+        salida.write(reinterpret_cast<const char*>(&longitud), sizeof(longitud));
+        carga.escribirMensaje(salida);
+        salida.write(MAGIA_FIN, sizeof(MAGIA_FIN));
+        salida.close();
+        if (!salida) return false;
+    }
+    
+    sincronizarArchivo(rutaTemporal);
+    if (!reemplazarArchivo(rutaTemporal, rutaEstado)) return false;
+    return iniciarDiario();
+}
+
+bool PersistenciaEstado::registrar(const TramaValor& trama, const ListaDeCarga& carga, const RotorDeMapeo& rotor) {
+    if (!diario) return false;
+    
+    if (enBuffer + PRT7_MAX_BYTES_TRAMA > TAMANO_BUFFER_DIARIO && !vaciar()) return false;
+    int n = codificarTramaBinaria(trama, buffer + enBuffer);
+    if (n == 0) return true;
+    enBuffer += n;
+    tramasAplicadas++;
+    tramasEnDiario++;
+    
+    long limite = carga.getLongitud() / 4;
+    if (limite < TRAMAS_MINIMAS_POR_INSTANTANEA) limite = TRAMAS_MINIMAS_POR_INSTANTANEA;
+    if (tramasEnDiario >= limite) {
+        return guardarInstantanea(carga, rotor);
+    }
+    return true;
+}
+
+bool PersistenciaEstado::vaciar() {
+    if (enBuffer == 0) return true;
+    if (!diario) return false;
+    
+    bool correcto = fwrite(buffer, 1, enBuffer, diario) == (size_t)enBuffer && fflush(diario) == 0;
+    enBuffer = 0;
+    return correcto;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file PersistenciaEstado.h
+ * @brief Instantáneas y diario de tramas para recuperar el estado tras un reinicio
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef PERSISTENCIA_ESTADO_H
+#define PERSISTENCIA_ESTADO_H
+
+#include <cstdio>
+#include "TramaValor.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+/**
+ * @class PersistenciaEstado
+ * @brief Guarda el rotor y la lista de carga en disco de forma incremental
+ *
+ * Usa dos archivos a partir de una ruta base:
+ *  - RUTA.estado: instantánea con la posición del rotor, el total de tramas
+ *    aplicadas y el mensaje decodificado. Se escribe en RUTA.estado.tmp y se
+ *    renombra, así que siempre hay una instantánea completa.
+ *  - RUTA.diario: tramas aplicadas desde la instantánea, en el formato de
+ *    ProtocoloBinario.h, agregadas al final.
+ *
+ * Al arrancar se carga la instantánea y se reaplica sólo la cola del
+ * diario; el diario lleva el número de la primera trama que contiene, de
+ * modo que un corte entre el renombre y el vaciado del diario no aplica
+ * dos veces las mismas tramas. Una nueva instantánea se toma cuando el
+ * diario supera un cuarto del mensaje (o un mínimo fijo): el costo de
+ * escribirlas queda amortizado en O(1) por trama y la recuperación nunca
+ * reaplica más tramas que las que ocupa el mensaje.
+ *
+ * Los enteros se guardan en el orden de bytes de la máquina: los archivos
+ * no están pensados para moverse entre arquitecturas.
+ */
+class PersistenciaEstado {
+private:
+    static const long TRAMAS_MINIMAS_POR_INSTANTANEA = 65536;
+    static const int TAMANO_BUFFER_DIARIO = 4096;
+
+    char* rutaEstado;          ///< Ruta de la instantánea
+    char* rutaTemporal;        ///< Ruta temporal de la instantánea
+    char* rutaDiario;          ///< Ruta del diario
+    FILE* diario;              ///< Diario abierto para agregar
+    unsigned char buffer[TAMANO_BUFFER_DIARIO]; ///< Tramas aún no escritas en el diario
+    int enBuffer;              ///< Bytes usados en buffer
+    long long tramasAplicadas; ///< Tramas aplicadas desde el inicio del flujo
+    long tramasEnDiario;       ///< Tramas agregadas desde la última instantánea
+    long tramasReaplicadas;    ///< Tramas del diario reaplicadas al recuperar
+    bool huboHueco;            ///< El diario no continuaba a la instantánea
+
+    /**
+     * @brief Carga la instantánea, si existe y está completa
+     * @param carga Lista que recibe el mensaje guardado
+     * @param rotor Rotor que recibe la posición guardada
+     * @return true si se cargó una instantánea
+     */
+    bool cargarInstantanea(ListaDeCarga* carga, RotorDeMapeo* rotor);
+
+    /**
+     * @brief Reaplica las tramas del diario posteriores a la instantánea
+     * @param carga Lista de carga
+     * @param rotor Rotor de mapeo
+     */
+    void reaplicarDiario(ListaDeCarga* carga, RotorDeMapeo* rotor);
+
+    /**
+     * @brief Vacía el diario y escribe su cabecera
+     * @return false si no se pudo crear
+     */
+    bool iniciarDiario();
+
+    /**
+     * @brief Libera rutas y cierra el diario
+     */
+    void cerrar();
+
+public:
+    /**
+     * @brief Constructor sin archivos asociados
+     */
+    PersistenciaEstado();
+
+    /**
+     * @brief Destructor que escribe las tramas pendientes y cierra el diario
+     */
+    ~PersistenciaEstado();
+
+    PersistenciaEstado(const PersistenciaEstado&) = delete;
+    PersistenciaEstado& operator=(const PersistenciaEstado&) = delete;
+
+    /**
+     * @brief Recupera el estado guardado y empieza un diario nuevo
+     * @param rutaBase Ruta sin extensión de los archivos de estado
+     * @param carga Lista vacía que recibe el mensaje (su progreso queda apagado)
+     * @param rotor Rotor recién construido
+     * @return false si no se pudieron crear los archivos
+     *
+     * Tras recuperar se toma una instantánea, así el diario nuevo arranca
+     * limpio aunque el anterior terminara con una trama a medias.
+     */
+    bool abrir(const char* rutaBase, ListaDeCarga* carga, RotorDeMapeo* rotor);
+
+    /**
+     * @brief Agrega al diario una trama ya aplicada
+     * @param trama Trama aplicada
+     * @param carga Lista de carga tras aplicar la trama
+     * @param rotor Rotor tras aplicar la trama
+     * @return false si falló la escritura
+     *
+     * Las tramas se acumulan en memoria; se escriben al llenarse el buffer,
+     * con vaciar() o al tomar una instantánea.
+     */
+    bool registrar(const TramaValor& trama, const ListaDeCarga& carga, const RotorDeMapeo& rotor);
+
+    /**
+     * @brief Escribe en el diario las tramas acumuladas
+     * @return false si falló la escritura
+     *
+     * Conviene llamarlo antes de esperar más datos del puerto: todo lo
+     * recibido queda en el diario mientras el proceso está bloqueado.
+     */
+    bool vaciar();
+
+    /**
+     * @brief Escribe una instantánea y reinicia el diario
+     * @param carga Lista de carga
+     * @param rotor Rotor de mapeo
+     * @return false si falló la escritura
+     */
+    bool guardarInstantanea(const ListaDeCarga& carga, const RotorDeMapeo& rotor);
+
+    /**
+     * @brief Tramas del diario reaplicadas en abrir()
+     * @return Cantidad de tramas
+     */
+    long getTramasReaplicadas() const { return tramasReaplicadas; }
+
+    /**
+     * @brief Tramas aplicadas desde el inicio del flujo, incluidas las recuperadas
+     * @return Cantidad de tramas
+     */
+    long long getTramasAplicadas() const { return tramasAplicadas; }
+
+    /**
+     * @brief Indica si faltaban tramas entre la instantánea y el diario
+     * @return true si la recuperación no pudo ser exacta
+     */
+    bool getHuboHueco() const { return huboHueco; }
+};
+
+#endif // PERSISTENCIA_ESTADO_H
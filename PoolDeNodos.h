@@ -0,0 +1,180 @@
+/**
+ * @file PoolDeNodos.h
+ * @brief Asignador por bloques para los nodos de las listas enlazadas
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef POOL_DE_NODOS_H
+#define POOL_DE_NODOS_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * @class PoolDeNodos
+ * @brief Reparte nodos desde bloques contiguos y los libera todos juntos
+ *
+ * En lugar de un new/delete por nodo, los nodos se toman de bloques grandes
+ * que crecen al doble hasta un máximo. Los nodos devueltos con liberar() se
+ * reutilizan en las siguientes llamadas a crear(); los bloques sólo se
+ * devuelven al sistema en el destructor.
+ *
+ * @tparam T Tipo de nodo (debe ser trivialmente destructible)
+ */
+template <typename T>
+class PoolDeNodos {
+private:
+    /**
+     * @struct Bloque
+     * @brief Cabecera de cada bloque reservado; los nodos van a continuación
+     */
+    struct Bloque {
+        Bloque* siguiente; ///< Bloque reservado anteriormente
+        size_t bytes;      ///< Tamaño total del bloque incluyendo la cabecera
+    };
+
+    /**
+     * @brief Ranura de un nodo libre, enlazada en la lista de libres
+     */
+    struct Libre {
+        Libre* siguiente; ///< Siguiente ranura libre
+    };
+
+    static const size_t TAMANO_RANURA = sizeof(T) > sizeof(Libre) ? sizeof(T) : sizeof(Libre);
+    static const size_t INICIO_RANURAS =
+        (sizeof(Bloque) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    Bloque* bloques;          ///< Lista de bloques reservados
+    char* actual;             ///< Siguiente ranura sin usar del bloque más reciente
+    char* fin;                ///< Fin del bloque más reciente
+    Libre* libres;            ///< Ranuras devueltas con liberar()
+    size_t nodosSiguiente;    ///< Nodos del próximo bloque a reservar
+    size_t nodosMaximo;       ///< Límite de nodos por bloque
+    size_t bytesReservados;   ///< Bytes pedidos al sistema
+    size_t nodosEnUso;        ///< Nodos entregados y no liberados
+
+    /**
+     * @brief Reserva un bloque nuevo y lo deja como bloque actual
+     */
+    void reservarBloque() {
+        size_t bytes = INICIO_RANURAS + nodosSiguiente * TAMANO_RANURA;
+        Bloque* bloque = static_cast<Bloque*>(::operator new(bytes));
+        bloque->siguiente = bloques;
+        bloque->bytes = bytes;
+        bloques = bloque;
+
+        actual = reinterpret_cast<char*>(bloque) + INICIO_RANURAS;
+        fin = reinterpret_cast<char*>(bloque) + bytes;
+        bytesReservados += bytes;
+
+        if (nodosSiguiente < nodosMaximo) {
+            nodosSiguiente *= 2;
+            if (nodosSiguiente > nodosMaximo) nodosSiguiente = nodosMaximo;
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor; no reserva memoria hasta el primer crear()
+     * @param nodosIniciales Nodos del primer bloque
+     * @param nodosMaximoPorBloque Límite de nodos por bloque
+     */
+    explicit PoolDeNodos(size_t nodosIniciales = 64, size_t nodosMaximoPorBloque = 65536)
+        : bloques(nullptr), actual(nullptr), fin(nullptr), libres(nullptr),
+          nodosSiguiente(nodosIniciales ? nodosIniciales : 1),
+          nodosMaximo(nodosMaximoPorBloque), bytesReservados(0), nodosEnUso(0) {
+        if (nodosMaximo < nodosSiguiente) nodosMaximo = nodosSiguiente;
+    }
+
+    /**
+     * @brief Destructor que devuelve todos los bloques de una vez
+     */
+    ~PoolDeNodos() {
+        while (bloques) {
+            Bloque* temp = bloques;
+            bloques = bloques->siguiente;
+            ::operator delete(temp);
+        }
+    }
+
+    PoolDeNodos(const PoolDeNodos&) = delete;
+    PoolDeNodos& operator=(const PoolDeNodos&) = delete;
+
+    /**
+     * @brief Construye un nodo en una ranura del pool
+     * @param args Argumentos para el constructor de T
+     * @return Puntero al nodo construido
+     */
+    template <typename... Args>
+    T* crear(Args&&... args) {
+        void* ranura;
+        if (libres) {
+            ranura = libres;
+            libres = libres->siguiente;
+        } else {
+            if (actual == fin) reservarBloque();
+            ranura = actual;
+            actual += TAMANO_RANURA;
+        }
+        nodosEnUso++;
+        return new (ranura) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Devuelve un nodo al pool para reutilizar su ranura
+     * @param nodo Nodo obtenido con crear() de este mismo pool
+     */
+    void liberar(T* nodo) {
+        Libre* libre = reinterpret_cast<Libre*>(nodo);
+        libre->siguiente = libres;
+        libres = libre;
+        nodosEnUso--;
+    }
+
+    /**
+     * @brief Toma posesión de todos los bloques de otro pool
+     * @param otro Pool cuyos nodos pasan a pertenecer a éste; queda vacío
+     *
+     * Se usa al concatenar listas: los nodos movidos siguen siendo válidos
+     * y se liberan junto con este pool. Las ranuras libres del otro pool se
+     * descartan hasta la destrucción.
+     */
+    void absorber(PoolDeNodos& otro) {
+        if (&otro == this || !otro.bloques) return;
+
+        // Sólo se recorre la lista ajena: sus bloques se enlazan delante de
+        // los propios (el orden de la lista no importa, el bloque actual se
+        // sigue por 'actual' y 'fin')
+        Bloque* ultimo = otro.bloques;
+        while (ultimo->siguiente) {
+            ultimo = ultimo->siguiente;
+        }
+        ultimo->siguiente = bloques;
+        bloques = otro.bloques;
+
+        bytesReservados += otro.bytesReservados;
+        nodosEnUso += otro.nodosEnUso;
+
+        otro.bloques = nullptr;
+        otro.actual = otro.fin = nullptr;
+        otro.libres = nullptr;
+        otro.bytesReservados = 0;
+        otro.nodosEnUso = 0;
+    }
+
+    /**
+     * @brief Bytes pedidos al sistema por este pool
+     * @return Bytes reservados
+     */
+    size_t getBytesReservados() const { return bytesReservados; }
+
+    /**
+     * @brief Nodos entregados que no han sido liberados
+     * @return Nodos en uso
+     */
+    size_t getNodosEnUso() const { return nodosEnUso; }
+};
+
+#endif // POOL_DE_NODOS_H
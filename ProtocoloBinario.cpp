@@ -0,0 +1,129 @@
+/**
+ * @file ProtocoloBinario.cpp
+ * @brief Implementación del formato binario PRT-7
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "ProtocoloBinario.h"
+#include "Instrumentacion.h"
+
+int codificarTramaBinaria(const TramaValor& trama, unsigned char* destino) {
+    if (trama.tipo == TRAMA_LOAD) {
+        unsigned char c = (unsigned char)trama.caracter;
+        if (c == PRT7_ESCAPE || c == PRT7_SINCRONIA || c == '\n' || c > 0x7F) {
+            destino[0] = PRT7_ESCAPE;
+            destino[1] = c ^ 0x20;
+            return 2;
+        }
+        destino[0] = c;
+        return 1;
+    }
+    
+    if (trama.tipo == TRAMA_MAP) {
+        // Zigzag: los valores pequeños, positivos o negativos, quedan pequeños
+        unsigned long v = ((unsigned long)(unsigned int)trama.rotacion << 1) ^
+                          (unsigned long)(unsigned int)(trama.rotacion >> 31);
+        v &= 0xFFFFFFFFUL;
+        
+        int n = 0;
+        if (trama.rotor != 0) {
+            if (trama.rotor >= PRT7_LIMITE_SELECTOR) return 0;
+            destino[n++] = PRT7_ESCAPE;
+            destino[n++] = trama.rotor;
+        }
+        
+        destino[n] = (unsigned char)(0x80 | (v & 0x3F));
+        v >>= 6;
+        if (v) destino[n] |= 0x40;
+        n++;
+        
+        while (v) {
+            destino[n] = (unsigned char)(v & 0x7F);
+            v >>= 7;
+            if (v) destino[n] |= 0x80;
+            n++;
+        }
+        return n;
+    }
+    
+    return 0;
+}
+
+DecodificadorBinario::DecodificadorBinario()
+    : estado(ESPERANDO), valor(0), bits(0), rotor(0), malformadas(0) {}
+
+bool DecodificadorBinario::completarLoad(char caracter, TramaValor& trama) {
+    if (rotor != 0) {
+        // Un selector de rotor sólo puede preceder a un MAP
+        malformadas++;
+        PRT7_CONTAR(CONTADOR_MALFORMADAS, 1);
+        rotor = 0;
+    }
+    trama.tipo = TRAMA_LOAD;
+    trama.caracter = caracter;
+    return true;
+}
+
+bool DecodificadorBinario::completarMap(TramaValor& trama) {
+    // Deshacer el zigzag
+    unsigned int v = (unsigned int)(valor & 0xFFFFFFFFUL);
+    trama.tipo = TRAMA_MAP;
+    trama.rotor = rotor;
+    trama.rotacion = (int)((v >> 1) ^ (0u - (v & 1u)));
+    rotor = 0;
+    return true;
+}
+
+bool DecodificadorBinario::empujar(unsigned char byte, TramaValor& trama) {
+    switch (estado) {
+        case ESPERANDO:
+            if (byte == PRT7_SINCRONIA) return false;
+            if (byte == PRT7_ESCAPE) {
+                estado = ESCAPADO;
+                return false;
+            }
+            if (byte & 0x80) {
+                valor = byte & 0x3F;
+                bits = 6;
+                if (byte & 0x40) {
+                    estado = VARINT;
+                    return false;
+                }
+                return completarMap(trama);
+            }
+            return completarLoad((char)byte, trama);
+            
+        case ESCAPADO:
+            estado = ESPERANDO;
+            if (byte < PRT7_LIMITE_SELECTOR) {
+                rotor = byte;
+                return false;
+            }
+            return completarLoad((char)(byte ^ 0x20), trama);
+            
+        case VARINT:
+            valor |= (unsigned long)(byte & 0x7F) << bits;
+            bits += 7;
+            if (byte & 0x80) {
+                if (bits > 32) {
+                    // Más bytes de los que caben en una rotación de 32 bits;
+                    // los que siguen con 0x80 no son tramas nuevas
+                    malformadas++;
+                    PRT7_CONTAR(CONTADOR_MALFORMADAS, 1);
+                    estado = DESCARTANDO;
+                    rotor = 0;
+                }
+                return false;
+            }
+            estado = ESPERANDO;
+            return completarMap(trama);
+            
+        case DESCARTANDO:
+            // La rotación termina en el primer byte sin 0x80 (la sincronía
+            // 0x7E tampoco lo tiene)
+            if (!(byte & 0x80)) estado = ESPERANDO;
+            return false;
+    }
+    return false;
+}
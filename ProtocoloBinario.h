@@ -0,0 +1,103 @@
+/**
+ * @file ProtocoloBinario.h
+ * @brief Formato binario compacto del protocolo PRT-7
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Formato de cada trama en el canal binario:
+ *  - SINCRONIA (0x7E): marca el inicio del modo binario y se repite
+ *    periódicamente; fuera de una trama se ignora.
+ *  - LOAD: el carácter se envía tal cual en un solo byte (0x00-0x7F).
+ *    Los bytes 0x7D, 0x7E, 0x0A y los mayores a 0x7F se envían como
+ *    ESCAPE (0x7D) seguido del byte XOR 0x20.
+ *  - MAP: la rotación se codifica en zigzag (0, -1, 1, -2... -> 0, 1, 2, 3...)
+ *    y se envía como varint: el primer byte es 1 C VVVVVV (bit alto = MAP,
+ *    C = siguen más bytes, 6 bits de valor) y los siguientes son LEB128 de
+ *    7 bits. Las rotaciones entre -32 y 31 ocupan un solo byte.
+ *  - Selector de rotor: ESCAPE seguido de un byte R menor a 0x20 (que no
+ *    puede ser un carácter escapado) dirige el siguiente MAP al rotor R de
+ *    una cadena; sin selector el MAP va al rotor 0.
+ */
+
+#ifndef PROTOCOLO_BINARIO_H
+#define PROTOCOLO_BINARIO_H
+
+#include "TramaValor.h"
+
+const unsigned char PRT7_SINCRONIA = 0x7E; ///< Byte de sincronía del modo binario
+const unsigned char PRT7_ESCAPE = 0x7D;    ///< Prefijo de un carácter LOAD escapado
+const unsigned char PRT7_LIMITE_SELECTOR = 0x20; ///< Tras ESCAPE, los bytes menores eligen rotor
+const int PRT7_MAX_BYTES_TRAMA = 8;        ///< Longitud máxima de una trama codificada
+
+/**
+ * @brief Codifica una trama en formato binario
+ * @param trama Trama LOAD o MAP
+ * @param destino Buffer de al menos PRT7_MAX_BYTES_TRAMA bytes
+ * @return Bytes escritos (0 si la trama no es válida o su rotor no cabe
+ *         en el selector)
+ */
+int codificarTramaBinaria(const TramaValor& trama, unsigned char* destino);
+
+/**
+ * @class DecodificadorBinario
+ * @brief Máquina de estados que arma tramas a partir de bytes binarios
+ *
+ * Se alimenta byte a byte, por lo que una trama puede llegar partida entre
+ * varias lecturas del puerto.
+ */
+class DecodificadorBinario {
+private:
+    /**
+     * @enum Estado
+     * @brief Posición dentro de la trama actual
+     */
+    enum Estado {
+        ESPERANDO,  ///< Entre tramas
+        ESCAPADO,   ///< Tras un byte de escape
+        VARINT,     ///< Leyendo los bytes restantes de una rotación
+        DESCARTANDO ///< Saltando el resto de una rotación demasiado larga
+    };
+
+    Estado estado;     ///< Estado actual
+    unsigned long valor; ///< Valor zigzag acumulado
+    int bits;          ///< Bits ya acumulados en valor
+    unsigned char rotor; ///< Rotor elegido por el último selector
+    long malformadas;  ///< Rotaciones descartadas o selectores sin MAP
+
+    /**
+     * @brief Entrega una trama LOAD; un selector de rotor pendiente se descarta
+     * @param caracter Carácter recibido
+     * @param trama Trama resultante
+     * @return Siempre true
+     */
+    bool completarLoad(char caracter, TramaValor& trama);
+
+    /**
+     * @brief Entrega la trama MAP acumulada, dirigida al rotor seleccionado
+     * @param trama Trama resultante
+     * @return Siempre true
+     */
+    bool completarMap(TramaValor& trama);
+
+public:
+    /**
+     * @brief Constructor que deja la máquina entre tramas
+     */
+    DecodificadorBinario();
+
+    /**
+     * @brief Procesa un byte
+     * @param byte Byte recibido
+     * @param trama Trama completada, si la hay
+     * @return true si el byte completó una trama
+     */
+    bool empujar(unsigned char byte, TramaValor& trama);
+
+    /**
+     * @brief Rotaciones descartadas por estar mal formadas
+     * @return Cantidad de tramas descartadas
+     */
+    long getMalformadas() const { return malformadas; }
+};
+
+#endif // PROTOCOLO_BINARIO_H
@@ -0,0 +1,315 @@
+/**
+ * @file PuertoSerial.cpp
+ * @brief Implementación de la apertura y lectura del puerto serial
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "PuertoSerial.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <termios.h>
+#endif
+#ifdef __linux__
+    #include <sys/ioctl.h>
+    #include <linux/serial.h>
+#endif
+
+ConfiguracionSerial::ConfiguracionSerial()
+    : baudios(9600), vmin(1), vtime(0), bajaLatencia(false) {
+    ruta[0] = '\0';
+}
+
+const char* ConfiguracionSerial::getRuta() const {
+    if (ruta[0] != '\0') return ruta;
+#ifdef _WIN32
+    return "\\\\.\\COM3";
+#else
+    return "/dev/ttyUSB0";
+#endif
+}
+
+#ifndef _WIN32
+/**
+ * @brief Convierte baudios a la constante de termios
+ * @param baudios Velocidad en baudios
+ * @param velocidad Constante Bxxx correspondiente
+ * @return false si el sistema no define esa velocidad
+ */
+static bool velocidadTermios(long baudios, speed_t& velocidad) {
+    switch (baudios) {
+        case 1200: velocidad = B1200; return true;
+        case 2400: velocidad = B2400; return true;
+        case 4800: velocidad = B4800; return true;
+        case 9600: velocidad = B9600; return true;
+        case 19200: velocidad = B19200; return true;
+        case 38400: velocidad = B38400; return true;
+        case 57600: velocidad = B57600; return true;
+        case 115200: velocidad = B115200; return true;
+        case 230400: velocidad = B230400; return true;
+#ifdef B460800
+        case 460800: velocidad = B460800; return true;
+#endif
+#ifdef B500000
+        case 500000: velocidad = B500000; return true;
+#endif
+#ifdef B576000
+        case 576000: velocidad = B576000; return true;
+#endif
+#ifdef B921600
+        case 921600: velocidad = B921600; return true;
+#endif
+#ifdef B1000000
+        case 1000000: velocidad = B1000000; return true;
+#endif
+#ifdef B1152000
+        case 1152000: velocidad = B1152000; return true;
+#endif
+#ifdef B1500000
+        case 1500000: velocidad = B1500000; return true;
+#endif
+#ifdef B2000000
+        case 2000000: velocidad = B2000000; return true;
+#endif
+#ifdef B2500000
+        case 2500000: velocidad = B2500000; return true;
+#endif
+#ifdef B3000000
+        case 3000000: velocidad = B3000000; return true;
+#endif
+#ifdef B3500000
+        case 3500000: velocidad = B3500000; return true;
+#endif
+#ifdef B4000000
+        case 4000000: velocidad = B4000000; return true;
+#endif
+        default: return false;
+    }
+}
+
+long baudiosDeVelocidad(speed_t velocidad) {
+    static const long ADMITIDAS[] = {
+        1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800, 500000,
+        576000, 921600, 1000000, 1152000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000
+    };
+    for (size_t i = 0; i < sizeof(ADMITIDAS) / sizeof(ADMITIDAS[0]); i++) {
+        speed_t candidata;
+        if (velocidadTermios(ADMITIDAS[i], candidata) && candidata == velocidad) return ADMITIDAS[i];
+    }
+    return 0;
+}
+#endif
+
+bool esVelocidadSerialValida(long baudios) {
+#ifdef _WIN32
+    // DCB acepta cualquier valor; el controlador decide si lo soporta
+    return baudios >= 1200 && baudios <= 4000000;
+#else
+    speed_t velocidad;
+    return velocidadTermios(baudios, velocidad);
+#endif
+}
+
+bool leerEntero(const char* valor, long minimo, long maximo, long& resultado) {
+    if (*valor < '0' || *valor > '9') return false;
+    char* fin;
+    long numero = strtol(valor, &fin, 10);
+    if (*fin != '\0' || numero < minimo || numero > maximo) return false;
+    resultado = numero;
+    return true;
+}
+
+bool asignarOpcionSerial(ConfiguracionSerial& configuracion, const char* clave, const char* valor) {
+    long numero;
+    if (strcmp(clave, "puerto") == 0) {
+        size_t longitud = strlen(valor);
+        if (longitud == 0 || longitud >= (size_t)ConfiguracionSerial::LONGITUD_RUTA) return false;
+        memcpy(configuracion.ruta, valor, longitud + 1);
+        return true;
+    }
+    if (strcmp(clave, "baudios") == 0) {
+        if (!leerEntero(valor, 1, 4000000, numero) || !esVelocidadSerialValida(numero)) return false;
+        configuracion.baudios = numero;
+        return true;
+    }
+    if (strcmp(clave, "vmin") == 0) {
+        // Con VMIN=0 read() devuelve 0 al vencer VTIME, que se confundiría con el fin del flujo
+        if (!leerEntero(valor, 1, 255, numero)) return false;
+        configuracion.vmin = (int)numero;
+        return true;
+    }
+    if (strcmp(clave, "vtime") == 0) {
+        if (!leerEntero(valor, 0, 255, numero)) return false;
+        configuracion.vtime = (int)numero;
+        return true;
+    }
+    if (strcmp(clave, "baja_latencia") == 0) {
+        if (strcmp(valor, "si") == 0) {
+            configuracion.bajaLatencia = true;
+        } else if (strcmp(valor, "no") == 0) {
+            configuracion.bajaLatencia = false;
+        } else {
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Quita los espacios al principio y al final de un texto
+ * @param texto Texto a recortar (se modifica)
+ * @return Inicio del texto recortado
+ */
+static char* recortar(char* texto) {
+    while (*texto == ' ' || *texto == '\t') texto++;
+    char* fin = texto + strlen(texto);
+    while (fin > texto && (fin[-1] == ' ' || fin[-1] == '\t' || fin[-1] == '\r' || fin[-1] == '\n')) {
+        fin--;
+    }
+    *fin = '\0';
+    return texto;
+}
+
+bool cargarConfiguracionSerial(const char* ruta, ConfiguracionSerial& configuracion, int& lineaError) {
+    lineaError = 0;
+    FILE* archivo = fopen(ruta, "r");
+    if (!archivo) return false;
+    
+    char linea[512];
+    int numeroLinea = 0;
+    bool valida = true;
+    while (valida && fgets(linea, sizeof(linea), archivo)) {
+        numeroLinea++;
+        char* texto = recortar(linea);
+        if (*texto == '\0' || *texto == '#') continue;
+        
+        char* igual = strchr(texto, '=');
+        if (!igual) {
+            valida = false;
+            break;
+        }
+        *igual = '\0';
+        valida = asignarOpcionSerial(configuracion, recortar(texto), recortar(igual + 1));
+    }
+    fclose(archivo);
+    
+    if (!valida) lineaError = numeroLinea;
+    return valida;
+}
+
+#ifdef _WIN32
+HANDLE abrirPuertoSerial(const char* puerto, const ConfiguracionSerial& configuracion,
+                         bool* bajaLatenciaAplicada) {
+    if (bajaLatenciaAplicada) *bajaLatenciaAplicada = false;
+    HANDLE hSerial = CreateFileA(puerto, GENERIC_READ, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    
+    if (hSerial == INVALID_HANDLE_VALUE) {
+        return INVALID_HANDLE_VALUE;
+    }
+    
+    DCB dcbSerialParams = {0};
+    dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
+    
+    if (!GetCommState(hSerial, &dcbSerialParams)) {
+        CloseHandle(hSerial);
+        return INVALID_HANDLE_VALUE;
+    }
+    
+    // Win32 no tiene modo canónico: basta con 8N1 binario sin control de flujo por software
+    dcbSerialParams.BaudRate = (DWORD)configuracion.baudios;
+    dcbSerialParams.ByteSize = 8;
+    dcbSerialParams.StopBits = ONESTOPBIT;
+    dcbSerialParams.Parity = NOPARITY;
+    dcbSerialParams.fBinary = TRUE;
+    dcbSerialParams.fOutX = FALSE;
+    dcbSerialParams.fInX = FALSE;
+    
+    if (!SetCommState(hSerial, &dcbSerialParams)) {
+        CloseHandle(hSerial);
+        return INVALID_HANDLE_VALUE;
+    }
+    
+    // VTIME es la espera entre bytes; VMIN no tiene equivalente
+    COMMTIMEOUTS timeouts = {0};
+    timeouts.ReadIntervalTimeout = configuracion.vtime > 0 ? configuracion.vtime * 100 : 50;
+    timeouts.ReadTotalTimeoutConstant = 50;
+    timeouts.ReadTotalTimeoutMultiplier = 10;
+    
+    SetCommTimeouts(hSerial, &timeouts);
+    
+    return hSerial;
+}
+#else
+int abrirPuertoSerial(const char* puerto, const ConfiguracionSerial& configuracion,
+                      bool* bajaLatenciaAplicada) {
+    if (bajaLatenciaAplicada) *bajaLatenciaAplicada = false;
+    speed_t velocidad;
+    if (!velocidadTermios(configuracion.baudios, velocidad)) return -1;
+    
+    // Sin O_NONBLOCK, open() puede quedar esperando la portadora antes de
+    // que CLOCAL esté activo
+    int fd = open(puerto, O_RDONLY | O_NOCTTY | O_NONBLOCK);
+    
+    if (fd == -1) {
+        return -1;
+    }
+    
+    struct termios options;
+    if (tcgetattr(fd, &options) == 0) {
+        // Modo crudo: sin modo canónico, eco, señales ni traducción de '\r'
+        cfmakeraw(&options);
+        cfsetispeed(&options, velocidad);
+        cfsetospeed(&options, velocidad);
+        options.c_cflag |= (CLOCAL | CREAD);
+        options.c_cflag &= ~CSTOPB;
+        options.c_cc[VMIN] = (cc_t)configuracion.vmin;
+        options.c_cc[VTIME] = (cc_t)configuracion.vtime;
+        
+        // tcsetattr() tiene éxito si aplica cualquiera de los cambios: se
+        // comprueba que la velocidad pedida haya quedado
+        struct termios aplicadas;
+        if (tcsetattr(fd, TCSANOW, &options) != 0 || tcgetattr(fd, &aplicadas) != 0 ||
+            cfgetispeed(&aplicadas) != velocidad) {
+            close(fd);
+            return -1;
+        }
+        
+#ifdef __linux__
+        // En adaptadores USB (ftdi_sio) baja el temporizador de latencia a 1 ms
+        struct serial_struct serie;
+        if (configuracion.bajaLatencia && ioctl(fd, TIOCGSERIAL, &serie) == 0) {
+            serie.flags |= ASYNC_LOW_LATENCY;
+            if (ioctl(fd, TIOCSSERIAL, &serie) == 0 && bajaLatenciaAplicada) {
+                *bajaLatenciaAplicada = true;
+            }
+        }
+#endif
+    }
+    // Si no es una terminal (archivo o FIFO) se lee tal cual
+    
+    int banderas = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, banderas & ~O_NONBLOCK);
+    
+    return fd;
+}
+#endif
+
+#ifdef _WIN32
+long leerBytesSerial(HANDLE hSerial, char* buffer, long maxLen) {
+    DWORD bytesLeidos;
+    if (!ReadFile(hSerial, buffer, (DWORD)maxLen, &bytesLeidos, NULL)) {
+        return -1;
+    }
+    return (long)bytesLeidos;
+}
+#else
+long leerBytesSerial(int fd, char* buffer, long maxLen) {
+    return (long)read(fd, buffer, maxLen);
+}
+#endif
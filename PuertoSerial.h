@@ -0,0 +1,120 @@
+/**
+ * @file PuertoSerial.h
+ * @brief Apertura y lectura de líneas del puerto serial (Win32 y POSIX)
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef PUERTO_SERIAL_H
+#define PUERTO_SERIAL_H
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <termios.h>
+#endif
+
+/**
+ * @struct ConfiguracionSerial
+ * @brief Parámetros de la línea serial, de la línea de comandos o de un archivo
+ *
+ * El puerto se abre siempre en modo crudo (8N1, sin eco, sin modo canónico
+ * ni traducción de fin de línea): el decodificador arma las tramas, así que
+ * la disciplina de línea del núcleo sólo agregaría latencia.
+ */
+struct ConfiguracionSerial {
+    static const int LONGITUD_RUTA = 256; ///< Tamaño máximo de la ruta, con el '\0'
+
+    char ruta[LONGITUD_RUTA]; ///< Dispositivo; vacía para el predeterminado del sistema
+    long baudios;             ///< Velocidad de entrada y salida
+    int vmin;                 ///< Bytes mínimos por lectura (VMIN, 1 a 255)
+    int vtime;                ///< Espera entre bytes en décimas de segundo (VTIME, 0 a 255)
+    bool bajaLatencia;        ///< Pedir al controlador que no agrupe bytes (ASYNC_LOW_LATENCY)
+
+    /**
+     * @brief Valores por omisión: puerto del sistema a 9600 baudios, VMIN=1, VTIME=0
+     */
+    ConfiguracionSerial();
+
+    /**
+     * @brief Ruta a abrir
+     * @return La ruta configurada o la predeterminada ("COM3" o "/dev/ttyUSB0")
+     */
+    const char* getRuta() const;
+};
+
+/**
+ * @brief Indica si el sistema admite una velocidad
+ * @param baudios Velocidad en baudios
+ * @return true si es una de las velocidades estándar (hasta 4000000 en Linux)
+ */
+bool esVelocidadSerialValida(long baudios);
+
+#ifndef _WIN32
+/**
+ * @brief Baudios de una constante de termios, para informar la configuración de una terminal
+ * @param velocidad Constante Bxxx (ej. la que devuelve cfgetispeed())
+ * @return Velocidad en baudios o 0 si no es una de las admitidas
+ */
+long baudiosDeVelocidad(speed_t velocidad);
+#endif
+
+/**
+ * @brief Convierte un texto a entero sin aceptar restos ni signos de más
+ * @param valor Texto a convertir
+ * @param minimo Menor valor aceptado
+ * @param maximo Mayor valor aceptado
+ * @param resultado Valor convertido
+ * @return false si no es un número entero dentro del rango
+ *
+ * La usan las opciones del archivo serial y las de la línea de comandos.
+ */
+bool leerEntero(const char* valor, long minimo, long maximo, long& resultado);
+
+/**
+ * @brief Asigna una opción de la configuración serial
+ * @param configuracion Configuración a modificar
+ * @param clave puerto, baudios, vmin, vtime o baja_latencia
+ * @param valor Valor en texto (baja_latencia: si o no)
+ * @return false si la clave no existe o el valor no es válido; no se modifica nada
+ */
+bool asignarOpcionSerial(ConfiguracionSerial& configuracion, const char* clave, const char* valor);
+
+/**
+ * @brief Lee un archivo de configuración serial con líneas "clave=valor"
+ * @param ruta Archivo a leer; las líneas vacías y las que empiezan con '#' se ignoran
+ * @param configuracion Configuración a modificar
+ * @param lineaError Número de la primera línea inválida (0 si no se pudo abrir)
+ * @return false si no se pudo abrir o alguna línea es inválida
+ */
+bool cargarConfiguracionSerial(const char* ruta, ConfiguracionSerial& configuracion, int& lineaError);
+
+/**
+ * @brief Abre el puerto serial en modo crudo según el sistema operativo
+ * @param puerto Nombre del puerto (ej. "COM3" o "/dev/ttyUSB0")
+ * @param configuracion Velocidad, VMIN/VTIME y baja latencia
+ * @param bajaLatenciaAplicada Si no es nullptr, indica si el controlador aceptó la baja latencia
+ * @return Handle/descriptor del puerto o valor inválido si falla
+ */
+#ifdef _WIN32
+HANDLE abrirPuertoSerial(const char* puerto, const ConfiguracionSerial& configuracion,
+                         bool* bajaLatenciaAplicada = nullptr);
+#else
+int abrirPuertoSerial(const char* puerto, const ConfiguracionSerial& configuracion,
+                      bool* bajaLatenciaAplicada = nullptr);
+#endif
+
+/**
+ * @brief Lee los bytes disponibles del puerto sin interpretarlos
+ * @param handle Handle/descriptor del puerto
+ * @param buffer Destino de los bytes
+ * @param maxLen Tamaño del buffer
+ * @return Bytes leídos; 0 o negativo si el puerto se cerró o falló
+ */
+#ifdef _WIN32
+long leerBytesSerial(HANDLE hSerial, char* buffer, long maxLen);
+#else
+long leerBytesSerial(int fd, char* buffer, long maxLen);
+#endif
+
+#endif // PUERTO_SERIAL_H
@@ -0,0 +1,102 @@
+/**
+ * @file ReporteProgreso.cpp
+ * @brief Implementación de la clase ReporteProgreso
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "ReporteProgreso.h"
+#include <cstring>
+
+ReporteProgreso::ReporteProgreso()
+    : modo(PROGRESO_COMPLETO), tamVentana(0), ventana(nullptr), inicioVentana(0),
+      ocupadosVentana(0), texto(nullptr), longitudTexto(0), capacidadTexto(0), total(0) {}
+
+ReporteProgreso::~ReporteProgreso() {
+    liberar();
+}
+
+void ReporteProgreso::liberar() {
+    delete[] ventana;
+    delete[] texto;
+    ventana = nullptr;
+    texto = nullptr;
+    tamVentana = 0;
+    inicioVentana = 0;
+    ocupadosVentana = 0;
+    longitudTexto = 0;
+    capacidadTexto = 0;
+    total = 0;
+}
+
+void ReporteProgreso::configurar(ModoProgreso nuevoModo, int k) {
+    liberar();
+    modo = nuevoModo;
+
+    if (modo == PROGRESO_VENTANA) {
+        tamVentana = (k > 0) ? k : 1;
+        ventana = new char[tamVentana];
+    }
+}
+
+void ReporteProgreso::reiniciar() {
+    inicioVentana = 0;
+    ocupadosVentana = 0;
+    longitudTexto = 0;
+    total = 0;
+}
+
+void ReporteProgreso::agregarTexto(const char* datos, long n) {
+    if (longitudTexto + n > capacidadTexto) {
+        long nuevaCapacidad = capacidadTexto ? capacidadTexto : 64;
+        while (nuevaCapacidad < longitudTexto + n) {
+            nuevaCapacidad *= 2;
+        }
+
+        char* nuevo = new char[nuevaCapacidad];
+        if (texto) {
+            memcpy(nuevo, texto, longitudTexto);
+            delete[] texto;
+        }
+        texto = nuevo;
+        capacidadTexto = nuevaCapacidad;
+    }
+
+    memcpy(texto + longitudTexto, datos, n);
+    longitudTexto += n;
+}
+
+void ReporteProgreso::registrar(char dato) {
+    total++;
+
+    if (modo == PROGRESO_VENTANA) {
+        // Anillo: al llenarse se sobrescribe el carácter más antiguo
+        if (ocupadosVentana < tamVentana) {
+            ventana[(inicioVentana + ocupadosVentana) % tamVentana] = dato;
+            ocupadosVentana++;
+        } else {
+            ventana[inicioVentana] = dato;
+            inicioVentana = (inicioVentana + 1) % tamVentana;
+        }
+    } else if (modo == PROGRESO_COMPLETO) {
+        if (longitudTexto == 0) {
+            agregarTexto(&dato, 1);
+        } else {
+            char separador[3] = { ']', '[', dato };
+            agregarTexto(separador, 3);
+        }
+    }
+}
+
+void ReporteProgreso::imprimir(std::ostream& salida) const {
+    if (modo == PROGRESO_COMPLETO) {
+        salida << '[';
+        if (texto) salida.write(texto, longitudTexto);
+        salida << ']';
+    } else if (modo == PROGRESO_VENTANA) {
+        if (total > ocupadosVentana) salida << "[...]";
+        for (int i = 0; i < ocupadosVentana; i++) {
+            salida << '[' << ventana[(inicioVentana + i) % tamVentana] << ']';
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file ReporteProgreso.h
+ * @brief Subsistema de reporte de progreso alimentado incrementalmente por la lista de carga
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef REPORTE_PROGRESO_H
+#define REPORTE_PROGRESO_H
+
+#include <ostream>
+
+/**
+ * @enum ModoProgreso
+ * @brief Modos disponibles para mostrar el mensaje durante la decodificación
+ */
+enum ModoProgreso {
+    PROGRESO_APAGADO,  ///< No se muestra ningún progreso por trama
+    PROGRESO_VENTANA,  ///< Se muestran sólo los últimos K caracteres
+    PROGRESO_COMPLETO  ///< Se muestra el mensaje completo (formato original)
+};
+
+/**
+ * @class ReporteProgreso
+ * @brief Mantiene el texto de progreso actualizado carácter a carácter
+ *
+ * En lugar de recorrer la lista y crear una cadena nueva en cada trama,
+ * cada inserción en la lista se registra aquí en O(1) amortizado. En modo
+ * ventana se guarda un anillo con los últimos K caracteres; en modo completo
+ * se guarda el texto ya formateado ("H][O][L") en un buffer que crece al doble.
+ */
+class ReporteProgreso {
+private:
+    ModoProgreso modo;    ///< Modo de reporte actual
+    int tamVentana;       ///< Capacidad K de la ventana
+    char* ventana;        ///< Anillo con los últimos K caracteres
+    int inicioVentana;    ///< Índice del carácter más antiguo en el anillo
+    int ocupadosVentana;  ///< Cantidad de caracteres válidos en el anillo
+    char* texto;          ///< Mensaje formateado sin corchetes exteriores
+    long longitudTexto;   ///< Bytes usados en texto
+    long capacidadTexto;  ///< Bytes reservados en texto
+    long total;           ///< Total de caracteres registrados
+
+    /**
+     * @brief Libera los buffers y deja el reporte vacío
+     */
+    void liberar();
+
+    /**
+     * @brief Agrega bytes al texto formateado, duplicando la capacidad si hace falta
+     * @param datos Bytes a agregar
+     * @param n Cantidad de bytes
+     */
+    void agregarTexto(const char* datos, long n);
+
+public:
+    /**
+     * @brief Constructor que inicializa el reporte en modo completo
+     */
+    ReporteProgreso();
+
+    /**
+     * @brief Destructor que libera los buffers
+     */
+    ~ReporteProgreso();
+
+    ReporteProgreso(const ReporteProgreso&) = delete;
+    ReporteProgreso& operator=(const ReporteProgreso&) = delete;
+
+    /**
+     * @brief Cambia el modo de reporte y descarta lo registrado
+     * @param nuevoModo Modo a utilizar
+     * @param k Tamaño de la ventana (sólo para PROGRESO_VENTANA)
+     */
+    void configurar(ModoProgreso nuevoModo, int k = 0);
+
+    /**
+     * @brief Descarta lo registrado conservando el modo y la ventana
+     */
+    void reiniciar();
+
+    /**
+     * @brief Obtiene el modo de reporte actual
+     * @return Modo configurado
+     */
+    ModoProgreso getModo() const { return modo; }
+
+    /**
+     * @brief Registra un carácter recién insertado en la lista
+     * @param dato Carácter decodificado
+     */
+    void registrar(char dato);
+
+    /**
+     * @brief Escribe el mensaje con formato [X][Y][Z]
+     * @param salida Flujo de salida
+     *
+     * El costo depende sólo del modo: O(K) en ventana y una única escritura
+     * del texto ya armado en modo completo; nunca recorre la lista.
+     */
+    void imprimir(std::ostream& salida) const;
+};
+
+#endif // REPORTE_PROGRESO_H
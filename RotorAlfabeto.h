@@ -0,0 +1,257 @@
+/**
+ * @file RotorAlfabeto.h
+ * @brief Rotor parametrizado por su alfabeto con tablas generadas en compilación
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef ROTOR_ALFABETO_H
+#define ROTOR_ALFABETO_H
+
+/**
+ * @struct AlfabetoMayusculas
+ * @brief A-Z (el alfabeto original del PRT-7)
+ *
+ * El espacio queda fuera del anillo y no rota: una trama "L,Space" siempre
+ * produce un espacio y ninguna letra se convierte en espacio, así que el
+ * mapeo es una biyección para cualquier rotación.
+ */
+struct AlfabetoMayusculas {
+    static const int TAMANO = 26; ///< Símbolos del anillo
+
+    /**
+     * @brief Símbolo en una posición del anillo
+     * @param i Posición en [0, TAMANO)
+     * @return Símbolo
+     */
+    static constexpr unsigned char simbolo(int i) {
+        return (unsigned char)('A' + i);
+    }
+
+    /**
+     * @brief Posición de un byte en el anillo
+     * @param b Byte
+     * @return Posición (0 para los bytes que no pertenecen al anillo)
+     */
+    static constexpr int posicion(int b) {
+        return (b >= 'A' && b <= 'Z') ? b - 'A' : 0;
+    }
+
+    /**
+     * @brief Indica si un byte de entrada se transforma con la rotación
+     * @param b Byte
+     * @return false si el byte se devuelve sin cambios
+     */
+    static constexpr bool rota(int b) {
+        return b >= 'A' && b <= 'Z';
+    }
+};
+
+/**
+ * @struct AlfabetoImprimible
+ * @brief ASCII imprimible completo (0x20-0x7E): minúsculas, dígitos y signos
+ *
+ * Para firmware que envía algo más que mayúsculas. El espacio es un símbolo
+ * más del anillo y rota como los demás; los bytes de control y los mayores
+ * a 0x7E pasan sin cambios.
+ */
+struct AlfabetoImprimible {
+    static const int TAMANO = 95; ///< Símbolos del anillo
+
+    /**
+     * @brief Símbolo en una posición del anillo
+     * @param i Posición en [0, TAMANO)
+     * @return Símbolo
+     */
+    static constexpr unsigned char simbolo(int i) {
+        return (unsigned char)(0x20 + i);
+    }
+
+    /**
+     * @brief Posición de un byte en el anillo
+     * @param b Byte
+     * @return Posición (0 para los bytes que no pertenecen al anillo)
+     */
+    static constexpr int posicion(int b) {
+        return (b >= 0x20 && b <= 0x7E) ? b - 0x20 : 0;
+    }
+
+    /**
+     * @brief Indica si un byte de entrada se transforma con la rotación
+     * @param b Byte
+     * @return false si el byte se devuelve sin cambios
+     */
+    static constexpr bool rota(int b) {
+        return b >= 0x20 && b <= 0x7E;
+    }
+};
+
+/**
+ * @struct AlfabetoByte
+ * @brief Los 256 valores de un byte; todos rotan
+ */
+struct AlfabetoByte {
+    static const int TAMANO = 256; ///< Símbolos del anillo
+
+    /**
+     * @brief Símbolo en una posición del anillo
+     * @param i Posición en [0, TAMANO)
+     * @return Símbolo
+     */
+    static constexpr unsigned char simbolo(int i) {
+        return (unsigned char)i;
+    }
+
+    /**
+     * @brief Posición de un byte en el anillo
+     * @param b Byte
+     * @return El mismo byte
+     */
+    static constexpr int posicion(int b) {
+        return b;
+    }
+
+    /**
+     * @brief Indica si un byte de entrada se transforma con la rotación
+     * @param b Byte
+     * @return Siempre true
+     */
+    static constexpr bool rota(int b) {
+        return (void)b, true;
+    }
+};
+
+/**
+ * @enum AlfabetoTramas
+ * @brief Alfabeto con el que se decodifican las tramas LOAD (--alfabeto)
+ */
+enum AlfabetoTramas {
+    ALFABETO_MAYUSCULAS, ///< A-Z con RotorDeMapeo; el resto de bytes no cambia
+    ALFABETO_IMPRIMIBLE  ///< 0x20-0x7E con RotorImprimible, de un solo rotor
+};
+
+/**
+ * @brief Paquete de índices 0..N-1 para expandir tablas en compilación
+ */
+template <int... I>
+struct SecuenciaIndices {};
+
+template <int N, int... I>
+struct GenerarIndices : GenerarIndices<N - 1, N - 1, I...> {};
+
+template <int... I>
+struct GenerarIndices<0, I...> {
+    typedef SecuenciaIndices<I...> tipo;
+};
+
+/**
+ * @struct TablasAlfabeto
+ * @brief Tablas de consulta de un alfabeto, calculadas por el compilador
+ *
+ * - doble: el anillo repetido dos veces, para resolver (posición +
+ *   desplazamiento) mod TAMANO con un solo acceso.
+ * - posicion: posición en el anillo de cada byte.
+ * - mascara: 0xFF para los bytes que rotan y 0x00 para los que pasan sin
+ *   cambios, de modo que la selección no necesita un salto.
+ */
+template <typename Alfabeto,
+          typename Dobles = typename GenerarIndices<2 * Alfabeto::TAMANO>::tipo,
+          typename Bytes = typename GenerarIndices<256>::tipo>
+struct TablasAlfabeto;
+
+template <typename Alfabeto, int... D, int... B>
+struct TablasAlfabeto<Alfabeto, SecuenciaIndices<D...>, SecuenciaIndices<B...> > {
+    static constexpr unsigned char doble[sizeof...(D)] = { Alfabeto::simbolo(D % Alfabeto::TAMANO)... };
+    static constexpr unsigned short posicion[256] = { (unsigned short)Alfabeto::posicion(B)... };
+    static constexpr unsigned char mascara[256] = { (unsigned char)(Alfabeto::rota(B) ? 0xFF : 0x00)... };
+};
+
+template <typename Alfabeto, int... D, int... B>
+constexpr unsigned char TablasAlfabeto<Alfabeto, SecuenciaIndices<D...>, SecuenciaIndices<B...> >::doble[sizeof...(D)];
+template <typename Alfabeto, int... D, int... B>
+constexpr unsigned short TablasAlfabeto<Alfabeto, SecuenciaIndices<D...>, SecuenciaIndices<B...> >::posicion[256];
+template <typename Alfabeto, int... D, int... B>
+constexpr unsigned char TablasAlfabeto<Alfabeto, SecuenciaIndices<D...>, SecuenciaIndices<B...> >::mascara[256];
+
+/**
+ * @class RotorAlfabeto
+ * @brief Rueda de César sobre un alfabeto fijado en compilación
+ *
+ * Guarda sólo el desplazamiento; el mapeo es una consulta a tablas
+ * constantes sin saltos y se expande en línea en el llamador. Con
+ * AlfabetoMayusculas produce exactamente el mismo resultado que
+ * RotorDeMapeo.
+ *
+ * @tparam Alfabeto AlfabetoMayusculas, AlfabetoImprimible o AlfabetoByte
+ */
+template <typename Alfabeto>
+class RotorAlfabeto {
+private:
+    typedef TablasAlfabeto<Alfabeto> Tablas;
+    int desplazamiento; ///< Posición de la cabeza en [0, TAMANO)
+
+public:
+    static const int TAMANO = Alfabeto::TAMANO; ///< Símbolos del anillo
+
+    /**
+     * @brief Constructor con la cabeza en la posición 0
+     */
+    RotorAlfabeto() : desplazamiento(0) {}
+
+    /**
+     * @brief Rota el rotor N posiciones
+     * @param N Posiciones a rotar (positivo o negativo)
+     */
+    void rotar(int N) {
+        desplazamiento = (desplazamiento + N % TAMANO + TAMANO) % TAMANO;
+    }
+
+    /**
+     * @brief Mapea un carácter con la rotación actual
+     * @param in Carácter de entrada
+     * @return Carácter mapeado; los que no rotan se devuelven sin cambios
+     */
+    char getMapeo(char in) const { return mapear(in, desplazamiento); }
+
+    /**
+     * @brief Mapea un carácter para una posición de cabeza dada
+     * @param in Carácter de entrada
+     * @param desplazamiento Posición de la cabeza en [0, TAMANO)
+     * @return Carácter mapeado
+     */
+    static char mapear(char in, int desplazamiento) {
+        unsigned char b = (unsigned char)in;
+        unsigned char rotado = Tablas::doble[Tablas::posicion[b] + desplazamiento];
+        unsigned char m = Tablas::mascara[b];
+        return (char)((rotado & m) | (b & (unsigned char)~m));
+    }
+
+    /**
+     * @brief Busca el carácter de entrada que produce una salida dada
+     * @param salida Carácter deseado
+     * @param desplazamiento Posición de la cabeza en [0, TAMANO)
+     * @return Carácter que mapear() convierte en 'salida'
+     *
+     * Todos los símbolos del anillo rotan, así que siempre hay una entrada.
+     */
+    static char invertir(char salida, int desplazamiento) {
+        unsigned char s = (unsigned char)salida;
+        if (!Tablas::mascara[s]) return salida;
+        int i = Tablas::posicion[s] - desplazamiento;
+        if (i < 0) i += TAMANO;
+        return (char)Tablas::doble[i];
+    }
+
+    /**
+     * @brief Obtiene la posición actual de la cabeza
+     * @return Desplazamiento en [0, TAMANO)
+     */
+    int getDesplazamiento() const { return desplazamiento; }
+};
+
+/**
+ * @brief Rotor sobre el ASCII imprimible, el que usa ALFABETO_IMPRIMIBLE
+ */
+typedef RotorAlfabeto<AlfabetoImprimible> RotorImprimible;
+
+#endif // ROTOR_ALFABETO_H
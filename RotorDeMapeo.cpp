@@ -7,76 +7,39 @@
 
 #include "RotorDeMapeo.h"
 
-RotorDeMapeo::RotorDeMapeo() {
+RotorDeMapeo::RotorDeMapeo() : pool(TAMANO_ALFABETO), desplazamiento(0) {
     // Crear el primer nodo con 'A'
-    cabeza = new NodoRotor('A');
+    cabeza = pool.crear('A');
+    nodos[0] = cabeza;
     NodoRotor* actual = cabeza;
     
     // Crear nodos para B-Z
     for (char c = 'B'; c <= 'Z'; c++) {
-        NodoRotor* nuevo = new NodoRotor(c);
+        NodoRotor* nuevo = pool.crear(c);
         actual->siguiente = nuevo;
         nuevo->previo = actual;
         actual = nuevo;
+        nodos[c - 'A'] = nuevo;
     }
     
-    // Crear nodo para espacio
-    NodoRotor* espacio = new NodoRotor(' ');
-    actual->siguiente = espacio;
-    espacio->previo = actual;
-    actual = espacio;
-    
     // Cerrar el círculo
     actual->siguiente = cabeza;
     cabeza->previo = actual;
 }
 
 RotorDeMapeo::~RotorDeMapeo() {
-    if (!cabeza) return;
-    
-    NodoRotor* actual = cabeza->siguiente;
-    while (actual != cabeza) {
-        NodoRotor* temp = actual;
-        actual = actual->siguiente;
-        delete temp;
-    }
-    delete cabeza;
+    // El pool libera el bloque con los 26 nodos
 }
 
 void RotorDeMapeo::rotar(int N) {
     if (!cabeza || N == 0) return;
     
-    if (N > 0) {
-        // Rotar a la derecha
-        for (int i = 0; i < N; i++) {
-            cabeza = cabeza->siguiente;
-        }
-    } else {
-        // Rotar a la izquierda
-        for (int i = 0; i < -N; i++) {
-            cabeza = cabeza->previo;
-        }
-    }
+    // Reducir primero para que rotaciones enormes no recorran nodos
+    int paso = N % TAMANO_ALFABETO;
+    desplazamiento = (desplazamiento + paso + TAMANO_ALFABETO) % TAMANO_ALFABETO;
+    cabeza = nodos[desplazamiento];
 }
 
-char RotorDeMapeo::getMapeo(char in) {
-    // Buscar el carácter en el rotor
-    NodoRotor* actual = cabeza;
-    int posicion = 0;
-    
-    do {
-        if (actual->dato == in) {
-            // Encontrado, ahora avanzar desde cabeza la misma cantidad
-            NodoRotor* resultado = cabeza;
-            for (int i = 0; i < posicion; i++) {
-                resultado = resultado->siguiente;
-            }
-            return resultado->dato;
-        }
-        posicion++;
-        actual = actual->siguiente;
-    } while (actual != cabeza);
-    
-    // Si no se encuentra, retornar el mismo carácter
-    return in;
-}
\ No newline at end of file
+char RotorDeMapeo::invertir(char salida, int desplazamiento) {
+    return RotorAlfabeto<AlfabetoMayusculas>::invertir(salida, desplazamiento);
+}
@@ -8,6 +8,9 @@
 #ifndef ROTOR_DE_MAPEO_H
 #define ROTOR_DE_MAPEO_H
 
+#include "PoolDeNodos.h"
+#include "RotorAlfabeto.h"
+
 /**
  * @struct NodoRotor
  * @brief Nodo de la lista circular doblemente enlazada del rotor
@@ -29,11 +32,20 @@ struct NodoRotor {
  * @brief Lista circular doblemente enlazada que actúa como disco de cifrado
  * 
  * Implementa una rueda de César que puede rotar para cambiar el mapeo
- * de caracteres dinámicamente.
+ * de caracteres dinámicamente. Además de la lista circular se guarda la
+ * posición de la cabeza como desplazamiento modular, de modo que rotar()
+ * y getMapeo() son O(1) sin importar la magnitud de la rotación. El mapeo
+ * usa las tablas de RotorAlfabeto<AlfabetoMayusculas> y se expande en línea.
  */
 class RotorDeMapeo {
+public:
+    static const int TAMANO_ALFABETO = 26; ///< Símbolos del rotor (A-Z)
+    
 private:
-    NodoRotor* cabeza; ///< Puntero a la posición cero actual del rotor
+    PoolDeNodos<NodoRotor> pool;           ///< Bloque único que contiene los 26 nodos
+    NodoRotor* cabeza;                     ///< Puntero a la posición cero actual del rotor
+    NodoRotor* nodos[TAMANO_ALFABETO];     ///< Acceso directo a cada nodo por su índice
+    int desplazamiento;                    ///< Índice del nodo cabeza (0 = 'A')
     
 public:
     /**
@@ -43,21 +55,63 @@ public:
     
     /**
      * @brief Destructor que libera la memoria de todos los nodos
+     *
+     * Los nodos se liberan junto con el bloque del pool.
      */
     ~RotorDeMapeo();
     
     /**
-     * @brief Rota el rotor N posiciones
+     * @brief Rota el rotor N posiciones en O(1)
      * @param N Número de posiciones a rotar (positivo o negativo)
      */
     void rotar(int N);
     
     /**
-     * @brief Obtiene el carácter mapeado según la rotación actual
+     * @brief Obtiene el carácter mapeado según la rotación actual en O(1)
      * @param in Carácter de entrada a mapear
-     * @return Carácter mapeado según la posición actual del rotor
+     * @return Carácter que ocupa la posición de 'in' contando desde la cabeza;
+     *         el espacio y los caracteres fuera del alfabeto no cambian
      */
-    char getMapeo(char in);
+    char getMapeo(char in) const { return mapear(in, desplazamiento); }
+    
+    /**
+     * @brief Mapea un carácter para una posición de cabeza dada
+     * @param in Carácter de entrada a mapear
+     * @param desplazamiento Posición de la cabeza en [0, TAMANO_ALFABETO)
+     * @return Carácter mapeado, igual que getMapeo() con esa rotación
+     */
+    static char mapear(char in, int desplazamiento) {
+        return RotorAlfabeto<AlfabetoMayusculas>::mapear(in, desplazamiento);
+    }
+    
+    /**
+     * @brief Busca el carácter de entrada que produce una salida dada
+     * @param salida Carácter que se desea obtener de getMapeo()
+     * @param desplazamiento Posición de la cabeza en [0, TAMANO_ALFABETO)
+     * @return Carácter que mapear() convierte en 'salida'
+     *
+     * Las letras rotan entre sí y el resto de bytes no cambia, así que toda
+     * salida tiene exactamente una entrada con cualquier rotación.
+     */
+    static char invertir(char salida, int desplazamiento);
+    
+    /**
+     * @brief Inverso de getMapeo() para la rotación actual
+     * @param salida Carácter que se desea obtener
+     * @return Carácter a enviar en una trama LOAD
+     */
+    char getInverso(char salida) const {
+        return invertir(salida, desplazamiento);
+    }
+    
+    /**
+     * @brief Obtiene la posición actual de la cabeza
+     * @return Desplazamiento en [0, TAMANO_ALFABETO)
+     */
+    int getDesplazamiento() const { return desplazamiento; }
 };
 
+static_assert(RotorAlfabeto<AlfabetoMayusculas>::TAMANO == RotorDeMapeo::TAMANO_ALFABETO,
+              "El rotor de nodos y sus tablas deben tener el mismo alfabeto");
+
 #endif // ROTOR_DE_MAPEO_H
\ No newline at end of file
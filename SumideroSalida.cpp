@@ -0,0 +1,61 @@
+/**
+ * @file SumideroSalida.cpp
+ * @brief Implementación de los sumideros de salida
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "SumideroSalida.h"
+#include <cerrno>
+#include <fcntl.h>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+bool SumideroFlujo::escribir(const char* datos, long n) {
+    salida.write(datos, n);
+    return (bool)salida;
+}
+
+bool SumideroFlujo::vaciar() {
+    salida.flush();
+    return (bool)salida;
+}
+
+bool SumideroDescriptor::escribir(const char* datos, long n) {
+    if (fd == -1) return false;
+    
+    while (n > 0) {
+#ifdef _WIN32
+        int escritos = _write(fd, datos, (unsigned int)n);
+#else
+        ssize_t escritos = write(fd, datos, n);
+#endif
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        datos += escritos;
+        n -= escritos;
+    }
+    return true;
+}
+
+#ifdef _WIN32
+SumideroArchivo::SumideroArchivo(const char* ruta)
+    : SumideroDescriptor(_open(ruta, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644)) {}
+
+SumideroArchivo::~SumideroArchivo() {
+    if (fd != -1) _close(fd);
+}
+#else
+SumideroArchivo::SumideroArchivo(const char* ruta)
+    : SumideroDescriptor(open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644)) {}
+
+SumideroArchivo::~SumideroArchivo() {
+    if (fd != -1) close(fd);
+}
+#endif
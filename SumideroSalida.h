@@ -0,0 +1,103 @@
+/**
+ * @file SumideroSalida.h
+ * @brief Destinos intercambiables para el mensaje decodificado (flujo, descriptor o archivo)
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef SUMIDERO_SALIDA_H
+#define SUMIDERO_SALIDA_H
+
+#include <ostream>
+
+/**
+ * @class SumideroSalida
+ * @brief Clase abstracta que recibe bloques del mensaje decodificado
+ */
+class SumideroSalida {
+public:
+    /**
+     * @brief Destructor virtual
+     */
+    virtual ~SumideroSalida() {}
+
+    /**
+     * @brief Escribe un bloque completo
+     * @param datos Bytes a escribir
+     * @param n Cantidad de bytes
+     * @return false si la escritura falló
+     */
+    virtual bool escribir(const char* datos, long n) = 0;
+
+    /**
+     * @brief Fuerza la salida de lo que el destino tenga en buffer
+     * @return false si falló
+     */
+    virtual bool vaciar() { return true; }
+};
+
+/**
+ * @class SumideroFlujo
+ * @brief Escribe en un std::ostream (ej. std::cout)
+ */
+class SumideroFlujo : public SumideroSalida {
+private:
+    std::ostream& salida; ///< Flujo de destino
+
+public:
+    /**
+     * @brief Constructor
+     * @param s Flujo de destino; debe vivir más que el sumidero
+     */
+    explicit SumideroFlujo(std::ostream& s) : salida(s) {}
+
+    bool escribir(const char* datos, long n) override;
+    bool vaciar() override;
+};
+
+/**
+ * @class SumideroDescriptor
+ * @brief Escribe directamente en un descriptor ya abierto, sin buffer intermedio
+ */
+class SumideroDescriptor : public SumideroSalida {
+protected:
+    int fd; ///< Descriptor de destino
+
+public:
+    /**
+     * @brief Constructor
+     * @param descriptor Descriptor abierto para escritura (no se cierra)
+     */
+    explicit SumideroDescriptor(int descriptor) : fd(descriptor) {}
+
+    bool escribir(const char* datos, long n) override;
+};
+
+/**
+ * @class SumideroArchivo
+ * @brief Crea (o trunca) un archivo y escribe en él
+ */
+class SumideroArchivo : public SumideroDescriptor {
+public:
+    /**
+     * @brief Constructor que abre el archivo
+     * @param ruta Ruta del archivo
+     */
+    explicit SumideroArchivo(const char* ruta);
+
+    /**
+     * @brief Destructor que cierra el archivo
+     */
+    ~SumideroArchivo() override;
+
+    SumideroArchivo(const SumideroArchivo&) = delete;
+    SumideroArchivo& operator=(const SumideroArchivo&) = delete;
+
+    /**
+     * @brief Indica si el archivo se pudo abrir
+     * @return true si está listo para escribir
+     */
+    bool estaAbierto() const { return fd != -1; }
+};
+
+#endif // SUMIDERO_SALIDA_H
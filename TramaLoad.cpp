@@ -6,23 +6,30 @@
  */
 
 #include "TramaLoad.h"
+#include "Instrumentacion.h"
 #include <iostream>
 
 TramaLoad::TramaLoad(char c) : caracter(c) {}
 
 void TramaLoad::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    procesarCaracter(caracter, carga, rotor);
+}
+
+void TramaLoad::procesarCaracter(char caracter, ListaDeCarga* carga, RotorDeMapeo* rotor) {
     char decodificado = rotor->getMapeo(caracter);
     carga->insertarAlFinal(decodificado);
     
     // Mostrar progreso
-    std::cout << "Trama recibida: [L," << caracter << "] -> Procesando... -> Fragmento '" 
-              << caracter << "' decodificado como '" << decodificado << "'. Mensaje: [";
+    imprimirProgreso(caracter, decodificado, carga->getProgreso());
+}
+
+void TramaLoad::imprimirProgreso(char caracter, char decodificado, const ReporteProgreso& progreso) {
+    if (progreso.getModo() == PROGRESO_APAGADO) return;
+    PRT7_MARCA(inicio);
     
-    char* mensaje = carga->obtenerMensaje();
-    for (int i = 0; mensaje[i] != '\0'; i++) {
-        std::cout << mensaje[i];
-        if (mensaje[i + 1] != '\0') std::cout << "][";
-    }
-    std::cout << "]" << std::endl;
-    delete[] mensaje;
+    std::cout << "Trama recibida: [L," << caracter << "] -> Procesando... -> Fragmento '" 
+              << caracter << "' decodificado como '" << decodificado << "'. Mensaje: ";
+    progreso.imprimir(std::cout);
+    std::cout << '\n';
+    PRT7_MEDIR(ETAPA_SALIDA, inicio);
 }
\ No newline at end of file
@@ -36,6 +36,22 @@ public:
      * @param rotor Rotor usado para mapear el carácter
      */
     void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+    
+    /**
+     * @brief Procesa un carácter LOAD sin necesidad de instanciar la trama
+     * @param caracter Carácter recibido en la trama
+     * @param carga Lista donde se insertará el carácter decodificado
+     * @param rotor Rotor usado para mapear el carácter
+     */
+    static void procesarCaracter(char caracter, ListaDeCarga* carga, RotorDeMapeo* rotor);
+    
+    /**
+     * @brief Muestra la línea de progreso de una trama LOAD ya decodificada
+     * @param caracter Carácter recibido en la trama
+     * @param decodificado Carácter resultante
+     * @param progreso Reporte que ya incluye el carácter decodificado
+     */
+    static void imprimirProgreso(char caracter, char decodificado, const ReporteProgreso& progreso);
 };
 
 #endif // TRAMA_LOAD_H
\ No newline at end of file
@@ -6,19 +6,38 @@
  */
 
 #include "TramaMap.h"
+#include "Instrumentacion.h"
 #include <iostream>
 
 TramaMap::TramaMap(int n) : rotacion(n) {}
 
 void TramaMap::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    procesarRotacion(rotacion, carga, rotor);
+}
+
+void TramaMap::procesarRotacion(int rotacion, ListaDeCarga* carga, RotorDeMapeo* rotor) {
     rotor->rotar(rotacion);
     
     // Mostrar progreso
-    std::cout << std::endl << "Trama recibida: [M," << rotacion << "] -> Procesando... -> ROTANDO ROTOR ";
+    if (carga->getProgreso().getModo() == PROGRESO_APAGADO) return;
+    imprimirProgreso(rotacion);
+}
+
+void TramaMap::imprimirProgreso(int rotacion, int rotor) {
+    PRT7_MARCA(inicio);
+    std::cout << "\nTrama recibida: [M,";
+    if (rotor != 0) {
+        std::cout << rotor << ",";
+    }
+    std::cout << rotacion << "] -> Procesando... -> ROTANDO ROTOR ";
+    if (rotor != 0) {
+        std::cout << rotor << " ";
+    }
     if (rotacion >= 0) {
         std::cout << "+" << rotacion;
     } else {
         std::cout << rotacion;
     }
-    std::cout << "." << std::endl << std::endl;
+    std::cout << ".\n\n";
+    PRT7_MEDIR(ETAPA_SALIDA, inicio);
 }
\ No newline at end of file
@@ -36,6 +36,21 @@ public:
      * @param rotor Rotor a rotar
      */
     void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+    
+    /**
+     * @brief Procesa una rotación MAP sin necesidad de instanciar la trama
+     * @param rotacion Número de posiciones a rotar
+     * @param carga Lista de carga (sólo se consulta su modo de progreso)
+     * @param rotor Rotor a rotar
+     */
+    static void procesarRotacion(int rotacion, ListaDeCarga* carga, RotorDeMapeo* rotor);
+    
+    /**
+     * @brief Muestra la línea de progreso de una trama MAP
+     * @param rotacion Número de posiciones rotadas
+     * @param rotor Rotor de la cadena que se movió (0 para el rotor único)
+     */
+    static void imprimirProgreso(int rotacion, int rotor = 0);
 };
 
 #endif // TRAMA_MAP_H
\ No newline at end of file
@@ -0,0 +1,35 @@
+/**
+ * @file TramaValor.h
+ * @brief Representación por valor de una trama PRT-7 ya parseada
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef TRAMA_VALOR_H
+#define TRAMA_VALOR_H
+
+/**
+ * @enum TipoTrama
+ * @brief Tipos de trama del protocolo PRT-7
+ */
+enum TipoTrama {
+    TRAMA_INVALIDA, ///< Línea mal formada
+    TRAMA_LOAD,     ///< Trama L,X con un fragmento de dato
+    TRAMA_MAP       ///< Trama M,N (o M,R,N) con una rotación
+};
+
+/**
+ * @struct TramaValor
+ * @brief Trama guardada por valor, sin jerarquía ni memoria dinámica
+ *
+ * Permite mantener buffers contiguos de tramas para procesarlas en lote,
+ * a diferencia de TramaBase que requiere un objeto en el heap por trama.
+ */
+struct TramaValor {
+    TipoTrama tipo; ///< Tipo de la trama
+    char caracter;  ///< Carácter de una trama LOAD
+    unsigned char rotor; ///< Rotor al que va dirigida una trama MAP (0 en "M,N")
+    int rotacion;   ///< Rotación de una trama MAP
+};
+
+#endif // TRAMA_VALOR_H
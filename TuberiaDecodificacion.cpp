@@ -0,0 +1,115 @@
+/**
+ * @file TuberiaDecodificacion.cpp
+ * @brief Implementación de la clase TuberiaDecodificacion
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#include "TuberiaDecodificacion.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "Instrumentacion.h"
+#include <chrono>
+#include <thread>
+
+/**
+ * @brief Espera creciente cuando una cola está llena o vacía
+ * @param intentos Intentos fallidos consecutivos (se incrementa)
+ *
+ * Primero cede el procesador y, si la espera se alarga, duerme para no
+ * consumir un núcleo completo mientras el puerto está en silencio.
+ */
+static void esperarCola(int& intentos) {
+    intentos++;
+    if (intentos < 64) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+}
+
+TuberiaDecodificacion::TuberiaDecodificacion(ListaDeCarga* c, RotorDeMapeo* r, ModoProgreso modoProgreso,
+                                             int k, size_t capacidad)
+    : colaTramas(capacidad), colaSalida(capacidad), carga(c), rotor(r),
+      modo(modoProgreso), ventana(k), tramas(0) {
+    carga->configurarProgreso(PROGRESO_APAGADO);
+}
+
+void TuberiaDecodificacion::etapaLectura(FuenteTramas fuente, void* contexto) {
+    TramaValor trama;
+
+    while (fuente(contexto, trama)) {
+        tramas++;
+
+        int intentos = 0;
+        while (!colaTramas.intentarInsertar(trama)) {
+            esperarCola(intentos);
+        }
+    }
+    colaTramas.cerrar();
+}
+
+void TuberiaDecodificacion::etapaDecodificacion() {
+    RegistroSalida registro;
+    int intentos = 0;
+
+    while (true) {
+        if (!colaTramas.intentarExtraer(registro.trama)) {
+            if (colaTramas.agotada()) break;
+            esperarCola(intentos);
+            continue;
+        }
+        intentos = 0;
+
+        PRT7_MARCA(inicio);
+        if (registro.trama.tipo == TRAMA_LOAD) {
+            registro.decodificado = rotor->getMapeo(registro.trama.caracter);
+            carga->insertarAlFinal(registro.decodificado);
+        } else {
+            if (registro.trama.rotor == 0) rotor->rotar(registro.trama.rotacion);
+            registro.decodificado = '\0';
+        }
+        PRT7_MEDIR(ETAPA_PROCESAR, inicio);
+        PRT7_CONTAR(CONTADOR_TRAMAS, 1);
+
+        int intentosSalida = 0;
+        while (!colaSalida.intentarInsertar(registro)) {
+            esperarCola(intentosSalida);
+        }
+    }
+    colaSalida.cerrar();
+}
+
+void TuberiaDecodificacion::etapaSalida() {
+    ReporteProgreso progreso;
+    progreso.configurar(modo, ventana);
+
+    RegistroSalida registro;
+    int intentos = 0;
+
+    while (true) {
+        if (!colaSalida.intentarExtraer(registro)) {
+            if (colaSalida.agotada()) break;
+            esperarCola(intentos);
+            continue;
+        }
+        intentos = 0;
+
+        if (registro.trama.tipo == TRAMA_LOAD) {
+            progreso.registrar(registro.decodificado);
+            TramaLoad::imprimirProgreso(registro.trama.caracter, registro.decodificado, progreso);
+        } else if (modo != PROGRESO_APAGADO && registro.trama.rotor == 0) {
+            TramaMap::imprimirProgreso(registro.trama.rotacion);
+        }
+    }
+}
+
+void TuberiaDecodificacion::ejecutar(FuenteTramas fuente, void* contexto) {
+    std::thread decodificador(&TuberiaDecodificacion::etapaDecodificacion, this);
+    std::thread salida(&TuberiaDecodificacion::etapaSalida, this);
+    std::thread lector(&TuberiaDecodificacion::etapaLectura, this, fuente, contexto);
+
+    lector.join();
+    decodificador.join();
+    salida.join();
+}
@@ -0,0 +1,125 @@
+/**
+ * @file TuberiaDecodificacion.h
+ * @brief Tubería de tres hilos (lectura, decodificación y salida) unidos por colas SPSC
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef TUBERIA_DECODIFICACION_H
+#define TUBERIA_DECODIFICACION_H
+
+#include <atomic>
+#include <cstddef>
+#include "ColaSPSC.h"
+#include "TramaValor.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "ReporteProgreso.h"
+
+/**
+ * @brief Función que entrega la siguiente trama de la fuente de datos
+ * @param contexto Dato opaco de la fuente (ej. lector del puerto)
+ * @param trama Trama leída
+ * @return false cuando la fuente terminó
+ *
+ * La fuente se encarga del formato (texto o binario) y de descartar las
+ * tramas mal formadas; la tubería sólo recibe tramas válidas.
+ */
+typedef bool (*FuenteTramas)(void* contexto, TramaValor& trama);
+
+/**
+ * @struct RegistroSalida
+ * @brief Trama ya aplicada, lista para que la etapa de salida la muestre
+ */
+struct RegistroSalida {
+    TramaValor trama;  ///< Trama procesada
+    char decodificado; ///< Carácter resultante (sólo LOAD)
+};
+
+/**
+ * @class TuberiaDecodificacion
+ * @brief Separa lectura, decodificación y salida en hilos distintos
+ *
+ * El hilo lector obtiene tramas de la fuente y las encola como TramaValor; el hilo
+ * decodificador aplica cada trama al rotor y a la lista y encola un
+ * RegistroSalida; el hilo de salida mantiene su propio ReporteProgreso y
+ * escribe en consola. Así una escritura lenta en consola nunca detiene las
+ * lecturas del puerto: sólo llena la cola de salida. La profundidad de
+ * cada cola muestra en qué etapa se acumula la contrapresión.
+ */
+class TuberiaDecodificacion {
+private:
+    ColaSPSC<TramaValor> colaTramas;     ///< Lector -> decodificador
+    ColaSPSC<RegistroSalida> colaSalida; ///< Decodificador -> salida
+    ListaDeCarga* carga;                 ///< Lista que recibe los datos decodificados
+    RotorDeMapeo* rotor;                 ///< Rotor de mapeo
+    ModoProgreso modo;                   ///< Modo de progreso de la etapa de salida
+    int ventana;                         ///< Tamaño de ventana del progreso
+    std::atomic<long> tramas;            ///< Tramas leídas
+
+    /**
+     * @brief Etapa de lectura
+     */
+    void etapaLectura(FuenteTramas fuente, void* contexto);
+
+    /**
+     * @brief Etapa de decodificación
+     */
+    void etapaDecodificacion();
+
+    /**
+     * @brief Etapa de salida a consola
+     */
+    void etapaSalida();
+
+public:
+    /**
+     * @brief Constructor
+     * @param c Lista de carga (su progreso se apaga: lo muestra la etapa de salida)
+     * @param r Rotor de mapeo
+     * @param modoProgreso Modo de progreso a mostrar
+     * @param k Tamaño de ventana para PROGRESO_VENTANA
+     * @param capacidad Capacidad de cada cola
+     */
+    TuberiaDecodificacion(ListaDeCarga* c, RotorDeMapeo* r, ModoProgreso modoProgreso,
+                          int k = 0, size_t capacidad = 4096);
+
+    /**
+     * @brief Ejecuta la tubería hasta que la fuente termine y todo se haya mostrado
+     * @param fuente Función de lectura de tramas
+     * @param contexto Dato opaco para la fuente
+     */
+    void ejecutar(FuenteTramas fuente, void* contexto);
+
+    /**
+     * @brief Tramas esperando a ser decodificadas
+     * @return Profundidad actual de la cola lector -> decodificador
+     */
+    size_t getProfundidadTramas() const { return colaTramas.profundidad(); }
+
+    /**
+     * @brief Registros esperando a ser mostrados
+     * @return Profundidad actual de la cola decodificador -> salida
+     */
+    size_t getProfundidadSalida() const { return colaSalida.profundidad(); }
+
+    /**
+     * @brief Mayor profundidad alcanzada por la cola de tramas
+     * @return Máximo observado
+     */
+    size_t getMaximoTramas() const { return colaTramas.profundidadMaxima(); }
+
+    /**
+     * @brief Mayor profundidad alcanzada por la cola de salida
+     * @return Máximo observado
+     */
+    size_t getMaximoSalida() const { return colaSalida.profundidadMaxima(); }
+
+    /**
+     * @brief Tramas leídas de la fuente
+     * @return Cantidad de tramas
+     */
+    long getTramas() const { return tramas.load(); }
+};
+
+#endif // TUBERIA_DECODIFICACION_H
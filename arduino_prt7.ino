@@ -6,8 +6,23 @@
  * 
  * Este código debe cargarse en el Arduino para simular el envío de tramas
  * del protocolo PRT-7 según el ejemplo del README.
+ *
+ * Con PRT7_BINARIO en 1 se envía el formato compacto de ProtocoloBinario.h:
+ * un byte de sincronía cada PRT7_PERIODO_SINCRONIA tramas, un byte por
+ * fragmento LOAD y un varint por rotación MAP. El decodificador detecta el
+ * formato solo, también si se conecta con el envío ya empezado.
  */
 
+// 0 = tramas de texto "L,X" / "M,N"; 1 = formato binario compacto
+#define PRT7_BINARIO 0
+
+const unsigned char PRT7_SINCRONIA = 0x7E;
+const unsigned char PRT7_ESCAPE = 0x7D;
+
+// Un decodificador que se conecta a mitad del envío espera una sincronía
+// para reconocer el formato binario
+const int PRT7_PERIODO_SINCRONIA = 4;
+
 // Tramas a enviar según el ejemplo del README
 const char* tramas[] = {
   "L,H",
@@ -39,10 +54,46 @@ void setup() {
   delay(2000); // Espera inicial
 }
 
+/**
+ * @brief Envía una trama de texto en formato binario
+ * @param trama Trama "L,X" o "M,N"
+ */
+void enviarBinario(const char* trama) {
+  if (trama[0] == 'L') {
+    unsigned char c = (strcmp(&trama[2], "Space") == 0) ? ' ' : (unsigned char)trama[2];
+    if (c == PRT7_ESCAPE || c == PRT7_SINCRONIA || c == '\n' || c > 0x7F) {
+      Serial.write(PRT7_ESCAPE);
+      c ^= 0x20;
+    }
+    Serial.write(c);
+  } else {
+    // Zigzag y varint: 1 C VVVVVV y luego bytes LEB128 de 7 bits
+    long n = atol(&trama[2]);
+    unsigned long v = ((unsigned long)n << 1) ^ (unsigned long)(n >> 31);
+    unsigned char primero = 0x80 | (v & 0x3F);
+    v >>= 6;
+    if (v) primero |= 0x40;
+    Serial.write(primero);
+    while (v) {
+      unsigned char b = v & 0x7F;
+      v >>= 7;
+      if (v) b |= 0x80;
+      Serial.write(b);
+    }
+  }
+}
+
 void loop() {
   if (indiceActual < numTramas) {
     // Enviar la trama actual
+#if PRT7_BINARIO
+    if (indiceActual % PRT7_PERIODO_SINCRONIA == 0) {
+      Serial.write(PRT7_SINCRONIA);
+    }
+    enviarBinario(tramas[indiceActual]);
+#else
     Serial.println(tramas[indiceActual]);
+#endif
     
     // Avanzar al siguiente índice
     indiceActual++;
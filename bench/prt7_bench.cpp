@@ -0,0 +1,523 @@
+/**
+ * @file prt7_bench.cpp
+ * @brief Micro-benchmarks y prueba de extremo a extremo del decodificador PRT-7
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Cada resultado se escribe como un objeto JSON por línea en la salida
+ * estándar, para poder guardar y comparar las corridas a lo largo del
+ * tiempo. Los operadores globales new/delete se reemplazan para contar
+ * las asignaciones de memoria de cada prueba.
+ *
+ * Uso: prt7_bench [--iteraciones=N] [--tramas=N] [--load=PORCENTAJE] [--semilla=S]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "ListaDeCarga.h"
+#include "ListaDeCargaDiferida.h"
+#include "RotorDeMapeo.h"
+#include "RotorAlfabeto.h"
+#include "CascadaRotores.h"
+#include "ParserTramas.h"
+#include "TramaBase.h"
+#include "TramaValor.h"
+#include "LectorTramas.h"
+#include "ProtocoloBinario.h"
+#include "EscritorAsincrono.h"
+#include "AnilloCompartido.h"
+#include "ContextoDecodificacion.h"
+#include <ostream>
+
+/**
+ * @brief Asignaciones realizadas con el operador new global
+ */
+static std::atomic<long> asignaciones(0);
+
+void* operator new(std::size_t bytes) {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(bytes ? bytes : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t bytes) {
+    return ::operator new(bytes);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/**
+ * @brief Destino de los resultados para que el compilador no elimine el trabajo medido
+ */
+static volatile long sumidero = 0;
+
+/**
+ * @struct Medicion
+ * @brief Tiempo y asignaciones de una prueba
+ */
+struct Medicion {
+    double segundos;   ///< Tiempo transcurrido
+    long asignaciones; ///< Llamadas a new durante la prueba
+};
+
+/**
+ * @brief Ejecuta una función midiendo tiempo y asignaciones
+ * @param trabajo Función a medir
+ * @return Medición obtenida
+ */
+template <typename Funcion>
+static Medicion medir(Funcion trabajo) {
+    long asignacionesIniciales = asignaciones.load();
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    trabajo();
+    std::chrono::steady_clock::time_point fin = std::chrono::steady_clock::now();
+    
+    Medicion medicion;
+    medicion.segundos = std::chrono::duration<double>(fin - inicio).count();
+    medicion.asignaciones = asignaciones.load() - asignacionesIniciales;
+    return medicion;
+}
+
+/**
+ * @brief Escribe el resultado de un micro-benchmark como una línea JSON
+ * @param nombre Nombre de la prueba
+ * @param operaciones Operaciones realizadas
+ * @param medicion Tiempo y asignaciones medidos
+ */
+static void reportarMicro(const char* nombre, long operaciones, const Medicion& medicion) {
+    double segundos = medicion.segundos > 0 ? medicion.segundos : 1e-9;
+    printf("{\"tipo\":\"micro\",\"prueba\":\"%s\",\"operaciones\":%ld,\"segundos\":%.6f,"
+           "\"ns_por_op\":%.3f,\"ops_por_segundo\":%.0f,\"asignaciones_por_op\":%.4f}\n",
+           nombre, operaciones, medicion.segundos, segundos * 1e9 / operaciones,
+           operaciones / segundos, (double)medicion.asignaciones / operaciones);
+}
+
+/**
+ * @brief Generador pseudoaleatorio reproducible (xorshift64)
+ */
+struct Aleatorio {
+    unsigned long long estado; ///< Estado interno, nunca cero
+
+    explicit Aleatorio(unsigned long long semilla) : estado(semilla ? semilla : 0x9E3779B97F4A7C15ULL) {}
+
+    /**
+     * @brief Siguiente valor pseudoaleatorio
+     * @return Valor de 64 bits
+     */
+    unsigned long long siguiente() {
+        estado ^= estado << 13;
+        estado ^= estado >> 7;
+        estado ^= estado << 17;
+        return estado;
+    }
+
+    /**
+     * @brief Entero uniforme en [0, n)
+     * @param n Límite superior exclusivo
+     * @return Valor en el rango
+     */
+    int entero(int n) { return (int)(siguiente() % (unsigned long long)n); }
+};
+
+/**
+ * @brief Genera una trama sintética
+ * @param aleatorio Generador
+ * @param porcentajeLoad Porcentaje de tramas LOAD (el resto son MAP)
+ * @param trama Trama generada
+ */
+static void generarTrama(Aleatorio& aleatorio, int porcentajeLoad, TramaValor& trama) {
+    if (aleatorio.entero(100) < porcentajeLoad) {
+        int simbolo = aleatorio.entero(RotorDeMapeo::TAMANO_ALFABETO + 1);
+        trama.tipo = TRAMA_LOAD;
+        trama.caracter = (simbolo < RotorDeMapeo::TAMANO_ALFABETO) ? (char)('A' + simbolo) : ' ';
+    } else {
+        trama.tipo = TRAMA_MAP;
+        trama.rotor = 0;
+        trama.rotacion = aleatorio.entero(61) - 30;
+    }
+}
+
+/**
+ * @brief Mide getMapeo() de un rotor con alfabeto fijado en compilación
+ * @param nombre Nombre de la prueba
+ * @param iteraciones Operaciones a realizar
+ */
+template <typename Alfabeto>
+static void medirRotorAlfabeto(const char* nombre, long iteraciones) {
+    RotorAlfabeto<Alfabeto> rotor;
+    rotor.rotar(3);
+    long acumulado = 0;
+    Medicion m = medir([&]() {
+        for (long i = 0; i < iteraciones; i++) {
+            acumulado += rotor.getMapeo((char)(0x20 + (i % 95)));
+        }
+    });
+    sumidero = sumidero + acumulado;
+    reportarMicro(nombre, iteraciones, m);
+}
+
+/**
+ * @brief Micro-benchmarks de las operaciones básicas
+ * @param iteraciones Operaciones por prueba
+ */
+static void microBenchmarks(long iteraciones) {
+    {
+        RotorDeMapeo rotor;
+        Medicion m = medir([&]() {
+            for (long i = 0; i < iteraciones; i++) {
+                rotor.rotar((int)(i & 63) - 31);
+            }
+        });
+        sumidero = sumidero + rotor.getDesplazamiento();
+        reportarMicro("rotor_rotar", iteraciones, m);
+    }
+    
+    {
+        RotorDeMapeo rotor;
+        rotor.rotar(3);
+        long acumulado = 0;
+        Medicion m = medir([&]() {
+            for (long i = 0; i < iteraciones; i++) {
+                acumulado += rotor.getMapeo((char)('A' + (i % 26)));
+            }
+        });
+        sumidero = sumidero + acumulado;
+        reportarMicro("rotor_getMapeo", iteraciones, m);
+    }
+    
+    {
+        // La decodificación no depende del largo de la cadena; la rotación sí
+        CascadaRotores cascada(8);
+        cascada.rotar(5, 3);
+        long acumulado = 0;
+        Medicion m = medir([&]() {
+            for (long i = 0; i < iteraciones; i++) {
+                acumulado += cascada.getMapeo((char)('A' + (i % 26)));
+            }
+        });
+        sumidero = sumidero + acumulado;
+        reportarMicro("cascada8_getMapeo", iteraciones, m);
+        
+        m = medir([&]() {
+            for (long i = 0; i < iteraciones; i++) {
+                cascada.rotar((int)(i & 7), (int)(i & 63) - 31);
+            }
+        });
+        sumidero = sumidero + cascada.getRotor(0).getDesplazamiento();
+        reportarMicro("cascada8_rotar", iteraciones, m);
+    }
+    
+    medirRotorAlfabeto<AlfabetoMayusculas>("rotorAlfabeto_mayusculas", iteraciones);
+    medirRotorAlfabeto<AlfabetoImprimible>("rotorAlfabeto_imprimible", iteraciones);
+    medirRotorAlfabeto<AlfabetoByte>("rotorAlfabeto_byte", iteraciones);
+    
+    {
+        ListaDeCarga carga;
+        carga.configurarProgreso(PROGRESO_APAGADO);
+        Medicion m = medir([&]() {
+            for (long i = 0; i < iteraciones; i++) {
+                carga.insertarAlFinal((char)('A' + (i % 26)));
+            }
+        });
+        sumidero = sumidero + carga.getLongitud();
+        reportarMicro("lista_insertarAlFinal", iteraciones, m);
+
+        // Acceso por posición con el índice: una división ubica la marca y
+        // quedan a lo sumo PASO_INDICE pasos por la lista
+        long acumulado = 0;
+        m = medir([&]() {
+            unsigned long posicion = 12345;
+            for (long i = 0; i < iteraciones; i++) {
+                posicion = posicion * 6364136223846793005UL + 1442695040888963407UL;
+                char dato = 0;
+                carga.caracterEn((long)((posicion >> 17) % (unsigned long)carga.getLongitud()), dato);
+                acumulado += dato;
+            }
+        });
+        sumidero = sumidero + acumulado;
+        reportarMicro("lista_caracterEn", iteraciones, m);
+
+        // Texto ausente: recorre toda la lista sin copiarla
+        m = medir([&]() {
+            sumidero = sumidero + carga.buscar("ZYX", 3);
+        });
+        reportarMicro("lista_buscar_por_fragmento", carga.getLongitud(), m);
+    }
+    
+    {
+        // Mensaje de tamaño fijo que se arma varias veces
+        const long LONGITUD_MENSAJE = 4096;
+        long repeticiones = iteraciones / LONGITUD_MENSAJE;
+        if (repeticiones < 1) repeticiones = 1;
+        
+        ListaDeCarga carga;
+        carga.configurarProgreso(PROGRESO_APAGADO);
+        for (long i = 0; i < LONGITUD_MENSAJE; i++) {
+            carga.insertarAlFinal((char)('A' + (i % 26)));
+        }
+        Medicion m = medir([&]() {
+            for (long i = 0; i < repeticiones; i++) {
+                char* mensaje = carga.obtenerMensaje();
+                sumidero = sumidero + mensaje[i % LONGITUD_MENSAJE];
+                delete[] mensaje;
+            }
+        });
+        reportarMicro("lista_obtenerMensaje_4096", repeticiones, m);
+    }
+    
+    {
+        // Misma carga guardada cruda: insertar no decodifica, leer sí.
+        // Una MAP cada 8 fragmentos, como en una captura con 80% de LOAD
+        ListaDeCargaDiferida diferida;
+        Medicion m = medir([&]() {
+            for (long i = 0; i < iteraciones; i++) {
+                diferida.insertarAlFinal((char)('A' + (i % 26)), (int)((i >> 3) % RotorDeMapeo::TAMANO_ALFABETO));
+            }
+        });
+        reportarMicro("diferida_insertarAlFinal", iteraciones, m);
+        
+        const long LONGITUD_MENSAJE = 4096;
+        long repeticiones = iteraciones / LONGITUD_MENSAJE;
+        if (repeticiones < 1) repeticiones = 1;
+        // Con pocas iteraciones la lista es más corta que un mensaje: se
+        // extrae siempre desde el principio (extraer() recorta el final)
+        long inicios = diferida.getLongitud() - LONGITUD_MENSAJE;
+        if (inicios < 1) inicios = 1;
+        char mensaje[LONGITUD_MENSAJE] = { 0 };
+        m = medir([&]() {
+            for (long i = 0; i < repeticiones; i++) {
+                diferida.extraer(i * LONGITUD_MENSAJE % inicios, LONGITUD_MENSAJE, mensaje);
+                sumidero = sumidero + mensaje[i % LONGITUD_MENSAJE];
+            }
+        });
+        reportarMicro("diferida_extraer_4096", repeticiones, m);
+    }
+    
+    {
+        // Un registro de progreso por trama, como TramaLoad::imprimirProgreso(),
+        // hacia /dev/null: se mide lo que paga el hilo que decodifica
+        SumideroArchivo nulo("/dev/null");
+        if (nulo.estaAbierto()) {
+            EscritorAsincrono escritor(&nulo);
+            std::ostream salida(&escritor);
+            Medicion m = medir([&]() {
+                for (long i = 0; i < iteraciones; i++) {
+                    char c = (char)('A' + (i % 26));
+                    salida << "Trama recibida: [L," << c << "] -> Procesando... -> Fragmento '"
+                           << c << "' decodificado como '" << c << "'. Mensaje: [" << c << "]\n";
+                }
+            });
+            escritor.cerrar();
+            reportarMicro("escritorAsincrono_registro", iteraciones, m);
+        }
+    }
+    
+    {
+        // Lo que agrega --publicar a cada trama LOAD, sin lectores conectados
+        PublicadorAnillo anillo;
+        if (anillo.crear("/prt7_bench")) {
+            Medicion m = medir([&]() {
+                for (long i = 0; i < iteraciones; i++) {
+                    char c = (char)('A' + (i % 26));
+                    anillo.publicarFragmento(c, c);
+                }
+            });
+            reportarMicro("anillo_publicarFragmento", iteraciones, m);
+            sumidero = sumidero + (long)anillo.getPublicados();
+            PublicadorAnillo::eliminar("/prt7_bench");
+        }
+    }
+    
+    {
+        const char* ejemplos[] = { "L,H", "L,Space", "M,2", "L,W", "M,-2", "L,O" };
+        const int NUM_EJEMPLOS = 6;
+        char lineas[NUM_EJEMPLOS][16];
+        for (int i = 0; i < NUM_EJEMPLOS; i++) {
+            strcpy(lineas[i], ejemplos[i]);
+        }
+        
+        Medicion m = medir([&]() {
+            for (long i = 0; i < iteraciones; i++) {
+                TramaBase* trama = parsearTrama(lineas[i % NUM_EJEMPLOS]);
+                sumidero = sumidero + (trama != nullptr);
+                delete trama;
+            }
+        });
+        reportarMicro("parsearTrama", iteraciones, m);
+        
+        TramaValor trama;
+        m = medir([&]() {
+            for (long i = 0; i < iteraciones; i++) {
+                sumidero = sumidero + parsearTramaValor(ejemplos[i % NUM_EJEMPLOS], trama);
+            }
+        });
+        reportarMicro("parsearTramaValor", iteraciones, m);
+        
+        // El mismo texto como llega del puerto, parseado por bloques
+        const long LINEAS_BLOQUE = 4096;
+        char* bloque = new char[LINEAS_BLOQUE * 16];
+        long bytesBloque = 0;
+        for (long i = 0; i < LINEAS_BLOQUE; i++) {
+            long longitud = (long)strlen(ejemplos[i % NUM_EJEMPLOS]);
+            memcpy(bloque + bytesBloque, ejemplos[i % NUM_EJEMPLOS], longitud);
+            bytesBloque += longitud;
+            bloque[bytesBloque++] = '\r';
+            bloque[bytesBloque++] = '\n';
+        }
+        
+        const long TRAMAS_POR_LOTE = 256;
+        TramaValor lote[TRAMAS_POR_LOTE];
+        long repeticionesBloque = iteraciones / LINEAS_BLOQUE + 1;
+        long malformadas = 0;
+        m = medir([&]() {
+            for (long r = 0; r < repeticionesBloque; r++) {
+                long inicio = 0;
+                while (inicio < bytesBloque) {
+                    long consumidos;
+                    long n = parsearBloqueTramas(bloque + inicio, bytesBloque - inicio, lote,
+                                                 TRAMAS_POR_LOTE, consumidos, malformadas);
+                    sumidero = sumidero + n + lote[0].tipo;
+                    inicio += consumidos;
+                }
+            }
+        });
+        reportarMicro("parsearBloqueTramas", repeticionesBloque * LINEAS_BLOQUE, m);
+        
+        // El mismo bloque por la interfaz de la biblioteca: empujar de a 4 KiB
+        // y drenar el mensaje, como lo haría un programa que la integra
+        ContextoDecodificacion contexto;
+        char mensaje[4096];
+        m = medir([&]() {
+            for (long r = 0; r < repeticionesBloque; r++) {
+                for (long inicio = 0; inicio < bytesBloque; inicio += (long)sizeof(mensaje)) {
+                    long n = bytesBloque - inicio < (long)sizeof(mensaje) ? bytesBloque - inicio : (long)sizeof(mensaje);
+                    contexto.empujar(bloque + inicio, n);
+                    sumidero = sumidero + contexto.drenar(mensaje, sizeof(mensaje));
+                }
+            }
+        });
+        reportarMicro("contexto_empujar_drenar", repeticionesBloque * LINEAS_BLOQUE, m);
+        delete[] bloque;
+    }
+}
+
+/**
+ * @brief Prueba de extremo a extremo: bytes del puerto hasta la lista de carga
+ * @param numTramas Tramas del flujo sintético
+ * @param porcentajeLoad Porcentaje de tramas LOAD
+ * @param semilla Semilla del generador
+ * @param binario true para el formato binario, false para texto
+ *
+ * El flujo se genera completo en memoria y luego se entrega al LectorTramas
+ * en lecturas de 256 bytes, como llegaría del puerto serial; cada trama se
+ * despacha al rotor y a la lista con el progreso apagado.
+ */
+static void extremoAExtremo(long numTramas, int porcentajeLoad, unsigned long long semilla, bool binario) {
+    long capacidad = numTramas * 16 + 1;
+    char* flujo = new char[capacidad];
+    long bytes = 0;
+    
+    Aleatorio aleatorio(semilla);
+    TramaValor trama;
+    if (binario) {
+        flujo[bytes++] = (char)PRT7_SINCRONIA;
+    }
+    for (long i = 0; i < numTramas; i++) {
+        generarTrama(aleatorio, porcentajeLoad, trama);
+        if (binario) {
+            bytes += codificarTramaBinaria(trama, reinterpret_cast<unsigned char*>(flujo + bytes));
+        } else {
+            bytes += formatearTramaTexto(trama, flujo + bytes);
+        }
+    }
+    
+    long procesadas = 0;
+    long malformadas = 0;
+    long fragmentos = 0;
+    Medicion m = medir([&]() {
+        LectorTramas lector;
+        ListaDeCarga carga;
+        RotorDeMapeo rotor;
+        carga.configurarProgreso(PROGRESO_APAGADO);
+        
+        const long LECTURA = 256;
+        long posicion = 0;
+        while (true) {
+            while (lector.siguiente(trama)) {
+                despacharTrama(trama, &carga, &rotor);
+                procesadas++;
+            }
+            if (posicion >= bytes) break;
+            long n = bytes - posicion < LECTURA ? bytes - posicion : LECTURA;
+            posicion += lector.empujar(flujo + posicion, n);
+        }
+        malformadas = lector.getMalformadas();
+        fragmentos = carga.getLongitud();
+    });
+    
+    double segundos = m.segundos > 0 ? m.segundos : 1e-9;
+    printf("{\"tipo\":\"e2e\",\"prueba\":\"%s\",\"tramas\":%ld,\"porcentaje_load\":%d,"
+           "\"semilla\":%llu,\"bytes\":%ld,\"bytes_por_trama\":%.3f,\"procesadas\":%ld,"
+           "\"malformadas\":%ld,\"fragmentos\":%ld,\"segundos\":%.6f,\"tramas_por_segundo\":%.0f,"
+           "\"ns_por_trama\":%.3f,\"asignaciones_por_trama\":%.4f}\n",
+           binario ? "e2e_binario" : "e2e_texto", numTramas, porcentajeLoad, semilla, bytes,
+           (double)bytes / (numTramas ? numTramas : 1), procesadas, malformadas, fragmentos,
+           m.segundos, procesadas / segundos, segundos * 1e9 / (procesadas ? procesadas : 1),
+           (double)m.asignaciones / (procesadas ? procesadas : 1));
+    
+    delete[] flujo;
+}
+
+/**
+ * @brief Lee el valor numérico de una opción --nombre=valor
+ * @param argumento Argumento de la línea de comandos
+ * @param prefijo Prefijo de la opción incluyendo el '='
+ * @param valor Valor leído
+ * @return true si el argumento corresponde a la opción
+ */
+static bool leerOpcion(const char* argumento, const char* prefijo, long long& valor) {
+    size_t n = strlen(prefijo);
+    if (strncmp(argumento, prefijo, n) != 0) return false;
+    valor = atoll(argumento + n);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    long long iteraciones = 10000000;
+    long long tramas = 1000000;
+    long long porcentajeLoad = 80;
+    long long semilla = 12345;
+    
+    for (int i = 1; i < argc; i++) {
+        if (leerOpcion(argv[i], "--iteraciones=", iteraciones) && iteraciones > 0) continue;
+        if (leerOpcion(argv[i], "--tramas=", tramas) && tramas > 0) continue;
+        if (leerOpcion(argv[i], "--load=", porcentajeLoad) && porcentajeLoad >= 0 && porcentajeLoad <= 100) continue;
+        if (leerOpcion(argv[i], "--semilla=", semilla)) continue;
+        fprintf(stderr, "Uso: %s [--iteraciones=N] [--tramas=N] [--load=PORCENTAJE] [--semilla=S]\n", argv[0]);
+        return 1;
+    }
+    
+    microBenchmarks((long)iteraciones);
+    extremoAExtremo((long)tramas, (int)porcentajeLoad, (unsigned long long)semilla, false);
+    extremoAExtremo((long)tramas, (int)porcentajeLoad, (unsigned long long)semilla, true);
+    return 0;
+}
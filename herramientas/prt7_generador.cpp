@@ -0,0 +1,404 @@
+/**
+ * @file prt7_generador.cpp
+ * @brief Generador de tráfico PRT-7 sintético a través de un pseudo-terminal
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Genera un flujo de tramas que el decodificador convierte en un mensaje
+ * conocido: aleatorio (con semilla) o a partir de un texto. Cada carácter se
+ * codifica con el inverso de la cadena de rotores (uno por omisión) y las
+ * rotaciones se intercalan al azar, así que el mensaje decodificado se puede comparar con
+ * el esperado. El flujo se escribe en un pseudo-terminal (o en un archivo)
+ * a la tasa pedida o tan rápido como el lector lo consuma.
+ *
+ * Uso:
+ *   prt7_generador [--tramas=N] [--texto=MENSAJE] [--load=PORCENTAJE]
+ *                  [--semilla=S] [--tasa=TRAMAS_POR_SEGUNDO] [--binario]
+ *                  [--pausa=MS] [--salida=RUTA] [--esperado=RUTA]
+ *                  [--rotores=N] [--verificar-terminal]
+ *
+ * Sin --salida se crea un pseudo-terminal y se muestra su ruta, que se
+ * pasa al decodificador con --puerto=RUTA o --puertos=RUTA. Con --rotores=N
+ * las tramas MAP usan el formato "M,R,N" y el decodificador necesita la
+ * misma cantidad de rotores. Con --verificar-terminal el pseudo-terminal
+ * queda en modo canónico, como un puerto recién conectado, y al terminar la
+ * pausa se informa la configuración que dejó el lector (modo, baudios,
+ * VMIN y VTIME).
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "RotorDeMapeo.h"
+#include "CascadaRotores.h"
+#include "ParserTramas.h"
+#include "ProtocoloBinario.h"
+#include "TramaValor.h"
+#include "PuertoSerial.h"
+
+/**
+ * @struct OpcionesGenerador
+ * @brief Parámetros de la línea de comandos
+ */
+struct OpcionesGenerador {
+    long tramas;             ///< Tramas a enviar (0 = una pasada del texto)
+    const char* texto;       ///< Mensaje a codificar o nullptr para aleatorio
+    int porcentajeLoad;      ///< Porcentaje de tramas LOAD voluntarias
+    unsigned long long semilla; ///< Semilla del generador
+    double tasa;             ///< Tramas por segundo (0 = sin límite)
+    bool binario;            ///< Formato binario en lugar de texto
+    long pausaMs;            ///< Espera antes de empezar a enviar
+    const char* salida;      ///< Archivo de salida o nullptr para pseudo-terminal
+    const char* esperado;    ///< Archivo donde guardar el mensaje esperado
+    int rotores;             ///< Rotores de la cadena del decodificador
+    bool verificarTerminal;  ///< No configurar el pseudo-terminal e informar cómo lo dejó el lector
+};
+
+/**
+ * @brief Generador pseudoaleatorio reproducible (xorshift64)
+ */
+struct Aleatorio {
+    unsigned long long estado; ///< Estado interno, nunca cero
+
+    explicit Aleatorio(unsigned long long semilla) : estado(semilla ? semilla : 0x9E3779B97F4A7C15ULL) {}
+
+    /**
+     * @brief Entero uniforme en [0, n)
+     * @param n Límite superior exclusivo
+     * @return Valor en el rango
+     */
+    int entero(int n) {
+        estado ^= estado << 13;
+        estado ^= estado >> 7;
+        estado ^= estado << 17;
+        return (int)(estado % (unsigned long long)n);
+    }
+};
+
+/**
+ * @class CodificadorPRT7
+ * @brief Convierte un mensaje en tramas que el decodificador reconstruye
+ *
+ * Lleva su propia cadena de rotores sincronizada con la del decodificador:
+ * cada MAP emitido se aplica también aquí, y cada LOAD lleva el carácter que
+ * getMapeo() transforma en el carácter del mensaje.
+ */
+class CodificadorPRT7 {
+private:
+    CascadaRotores cascada;  ///< Estado de los rotores visto por el decodificador
+    Aleatorio& aleatorio;    ///< Generador para rotaciones
+    int porcentajeLoad;      ///< Porcentaje de tramas LOAD voluntarias
+
+public:
+    CodificadorPRT7(Aleatorio& a, int load, int rotores)
+        : cascada(rotores), aleatorio(a), porcentajeLoad(load) {}
+
+    /**
+     * @brief Produce la siguiente trama para avanzar en el mensaje
+     * @param objetivo Carácter del mensaje que se quiere transmitir
+     * @param trama Trama generada
+     * @return true si la trama fue un LOAD que transmitió 'objetivo'
+     */
+    bool siguiente(char objetivo, TramaValor& trama) {
+        if (aleatorio.entero(100) >= porcentajeLoad) {
+            // Rotación al azar distinta de cero, a veces mayor que una vuelta
+            int rotacion = aleatorio.entero(60) - 30;
+            if (rotacion >= 0) rotacion++;
+            if (aleatorio.entero(16) == 0) rotacion *= 100;
+            int indice = cascada.getNumRotores() > 1 ? aleatorio.entero(cascada.getNumRotores()) : 0;
+            trama.tipo = TRAMA_MAP;
+            trama.rotor = (unsigned char)indice;
+            trama.rotacion = rotacion;
+            cascada.rotar(indice, rotacion);
+            return false;
+        }
+        
+        trama.tipo = TRAMA_LOAD;
+        trama.caracter = cascada.getInverso(objetivo);
+        return true;
+    }
+};
+
+/**
+ * @brief Crea un pseudo-terminal en modo crudo
+ * @param maestro Descriptor del lado maestro (donde escribe el generador)
+ * @param esclavo Descriptor del lado esclavo, abierto para conservar la configuración
+ * @param ruta Ruta del lado esclavo
+ * @return false si no se pudo crear
+ */
+static bool crearPseudoTerminal(int& maestro, int& esclavo, const char*& ruta, bool crudo) {
+    maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro == -1) return false;
+    if (grantpt(maestro) != 0 || unlockpt(maestro) != 0 || !(ruta = ptsname(maestro))) {
+        close(maestro);
+        return false;
+    }
+    
+    // Mantener el esclavo abierto evita que el maestro vea un cuelgue
+    // mientras el decodificador no se ha conectado
+    esclavo = open(ruta, O_RDWR | O_NOCTTY);
+    if (esclavo == -1) {
+        close(maestro);
+        return false;
+    }
+    
+    // Modo crudo: sin eco ni traducción de '\r', necesario para el formato binario
+    if (!crudo) return true;
+    struct termios opciones;
+    tcgetattr(esclavo, &opciones);
+    cfmakeraw(&opciones);
+    tcsetattr(esclavo, TCSANOW, &opciones);
+    return true;
+}
+
+/**
+ * @brief Escribe todos los bytes de un buffer
+ * @param fd Descriptor de destino
+ * @param datos Bytes a escribir
+ * @param n Cantidad de bytes
+ * @return false si la escritura falló
+ */
+static bool escribirTodo(int fd, const char* datos, long n) {
+    while (n > 0) {
+        ssize_t escritos = write(fd, datos, n);
+        if (escritos < 0) return false;
+        datos += escritos;
+        n -= escritos;
+    }
+    return true;
+}
+
+/**
+ * @brief Espera a que el decodificador lea lo pendiente en el pseudo-terminal
+ * @param esclavo Descriptor del lado esclavo, abierto por el generador
+ *
+ * Los bytes escritos en el maestro llegan al esclavo de forma asíncrona, así
+ * que una sola lectura de FIONREAD en cero no garantiza que el lector ya
+ * tenga todo: si se cuelga antes, los flujos cortos se pierden. La cola
+ * debe verse vacía durante 100 ms seguidos.
+ */
+static void esperarLecturaPendiente(int esclavo) {
+    int pendientes = 0;
+    int vaciasSeguidas = 0;
+    while (vaciasSeguidas < 10 && ioctl(esclavo, FIONREAD, &pendientes) == 0) {
+        vaciasSeguidas = (pendientes > 0) ? 0 : vaciasSeguidas + 1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+/**
+ * @brief Interpreta los argumentos
+ * @param argc Número de argumentos
+ * @param argv Argumentos
+ * @param opciones Opciones resultantes
+ * @return false si algún argumento no es válido
+ */
+static bool leerOpciones(int argc, char* argv[], OpcionesGenerador& opciones) {
+    opciones.tramas = -1;
+    opciones.texto = nullptr;
+    opciones.porcentajeLoad = 80;
+    opciones.semilla = 12345;
+    opciones.tasa = 0;
+    opciones.binario = false;
+    opciones.pausaMs = 0;
+    opciones.salida = nullptr;
+    opciones.esperado = nullptr;
+    opciones.rotores = 1;
+    opciones.verificarTerminal = false;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (strncmp(a, "--tramas=", 9) == 0) {
+            opciones.tramas = atol(a + 9);
+            if (opciones.tramas <= 0) return false;
+        } else if (strncmp(a, "--texto=", 8) == 0) {
+            opciones.texto = a + 8;
+        } else if (strncmp(a, "--load=", 7) == 0) {
+            opciones.porcentajeLoad = atoi(a + 7);
+            if (opciones.porcentajeLoad <= 0 || opciones.porcentajeLoad > 100) return false;
+        } else if (strncmp(a, "--semilla=", 10) == 0) {
+            opciones.semilla = strtoull(a + 10, nullptr, 10);
+        } else if (strncmp(a, "--tasa=", 7) == 0) {
+            opciones.tasa = atof(a + 7);
+            if (opciones.tasa < 0) return false;
+        } else if (strcmp(a, "--binario") == 0) {
+            opciones.binario = true;
+        } else if (strncmp(a, "--pausa=", 8) == 0) {
+            opciones.pausaMs = atol(a + 8);
+        } else if (strncmp(a, "--salida=", 9) == 0 && a[9] != '\0') {
+            opciones.salida = a + 9;
+        } else if (strncmp(a, "--esperado=", 11) == 0 && a[11] != '\0') {
+            opciones.esperado = a + 11;
+        } else if (strncmp(a, "--rotores=", 10) == 0) {
+            opciones.rotores = atoi(a + 10);
+            if (opciones.rotores < 1 || opciones.rotores > CascadaRotores::MAX_ROTORES) return false;
+        } else if (strcmp(a, "--verificar-terminal") == 0) {
+            opciones.verificarTerminal = true;
+        } else {
+            return false;
+        }
+    }
+    
+    if (opciones.texto) {
+        // El texto se limita al alfabeto del rotor: A-Z y espacio
+        for (const char* c = opciones.texto; *c; c++) {
+            char mayuscula = (*c >= 'a' && *c <= 'z') ? (char)(*c - 'a' + 'A') : *c;
+            if (mayuscula != ' ' && (mayuscula < 'A' || mayuscula > 'Z')) return false;
+        }
+        if (opciones.texto[0] == '\0') return false;
+    } else if (opciones.tramas < 0) {
+        opciones.tramas = 1000000;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    OpcionesGenerador opciones;
+    if (!leerOpciones(argc, argv, opciones)) {
+        fprintf(stderr, "Uso: %s [--tramas=N] [--texto=MENSAJE] [--load=PORCENTAJE] [--semilla=S]\n"
+                        "       [--tasa=TRAMAS_POR_SEGUNDO] [--binario] [--pausa=MS]\n"
+                        "       [--salida=RUTA] [--esperado=RUTA] [--rotores=N]\n"
+                        "       [--verificar-terminal]\n", argv[0]);
+        return 1;
+    }
+    
+    int destino = -1;
+    int esclavo = -1;
+    if (opciones.salida) {
+        destino = open(opciones.salida, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (destino == -1) {
+            fprintf(stderr, "No se pudo crear %s\n", opciones.salida);
+            return 1;
+        }
+    } else {
+        const char* ruta;
+        if (!crearPseudoTerminal(destino, esclavo, ruta, !opciones.verificarTerminal)) {
+            fprintf(stderr, "No se pudo crear el pseudo-terminal\n");
+            return 1;
+        }
+        fprintf(stderr, "Pseudo-terminal listo: %s\n", ruta);
+    }
+    
+    FILE* archivoEsperado = nullptr;
+    if (opciones.esperado) {
+        archivoEsperado = fopen(opciones.esperado, "w");
+        if (!archivoEsperado) {
+            fprintf(stderr, "No se pudo crear %s\n", opciones.esperado);
+            return 1;
+        }
+    }
+    
+    if (opciones.pausaMs > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(opciones.pausaMs));
+    }
+    
+    // El esclavo comparte la configuración con el descriptor del lector
+    struct termios lector;
+    if (opciones.verificarTerminal && esclavo != -1 && tcgetattr(esclavo, &lector) == 0) {
+        bool crudo = !(lector.c_lflag & (ICANON | ECHO | ISIG)) && !(lector.c_iflag & (ICRNL | IXON)) &&
+                     !(lector.c_oflag & OPOST);
+        fprintf(stderr, "Terminal del lector: modo %s, %ld baudios (salida %ld), VMIN=%d, VTIME=%d\n",
+                crudo ? "crudo" : "canonico", baudiosDeVelocidad(cfgetispeed(&lector)),
+                baudiosDeVelocidad(cfgetospeed(&lector)), (int)lector.c_cc[VMIN], (int)lector.c_cc[VTIME]);
+    }
+    
+    Aleatorio aleatorio(opciones.semilla);
+    CodificadorPRT7 codificador(aleatorio, opciones.porcentajeLoad, opciones.rotores);
+    
+    // Las tramas se acumulan y se escriben en bloques; con tasa limitada
+    // el bloque se escribe antes si la siguiente trama aún no toca
+    const long TAMANO_BLOQUE = 4096;
+    char bloque[TAMANO_BLOQUE + 32];
+    long enBloque = 0;
+    
+    // En binario la sincronía se repite para que un lector que se conecte
+    // a mitad del envío reconozca el formato
+    const long PERIODO_SINCRONIA = 256;
+    
+    long longitudTexto = opciones.texto ? (long)strlen(opciones.texto) : 0;
+    long posicionTexto = 0;
+    long enviadas = 0;
+    long bytes = 0;
+    long fragmentos = 0;
+    bool error = false;
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    
+    while (opciones.tramas < 0 ? posicionTexto < longitudTexto : enviadas < opciones.tramas) {
+        char objetivo;
+        if (opciones.texto) {
+            char c = opciones.texto[posicionTexto % longitudTexto];
+            objetivo = (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+        } else {
+            int simbolo = aleatorio.entero(RotorDeMapeo::TAMANO_ALFABETO + 1);
+            objetivo = (simbolo < RotorDeMapeo::TAMANO_ALFABETO) ? (char)('A' + simbolo) : ' ';
+        }
+        
+        // Emitir tramas hasta que un LOAD transmita el carácter objetivo
+        TramaValor trama;
+        bool transmitido = false;
+        while (!transmitido && (opciones.tramas < 0 || enviadas < opciones.tramas)) {
+            transmitido = codificador.siguiente(objetivo, trama);
+            if (opciones.binario) {
+                if (enviadas % PERIODO_SINCRONIA == 0) bloque[enBloque++] = (char)PRT7_SINCRONIA;
+                enBloque += codificarTramaBinaria(trama, reinterpret_cast<unsigned char*>(bloque + enBloque));
+            } else {
+                enBloque += formatearTramaTexto(trama, bloque + enBloque);
+            }
+            enviadas++;
+            
+            bool tocaEsperar = false;
+            std::chrono::steady_clock::time_point siguienteEnvio;
+            if (opciones.tasa > 0) {
+                siguienteEnvio = inicio + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(enviadas / opciones.tasa));
+                tocaEsperar = siguienteEnvio > std::chrono::steady_clock::now();
+            }
+            
+            if (enBloque >= TAMANO_BLOQUE || tocaEsperar) {
+                if (!escribirTodo(destino, bloque, enBloque)) {
+                    error = true;
+                    break;
+                }
+                bytes += enBloque;
+                enBloque = 0;
+            }
+            if (tocaEsperar) {
+                std::this_thread::sleep_until(siguienteEnvio);
+            }
+        }
+        if (error) break;
+        
+        if (transmitido) {
+            fragmentos++;
+            posicionTexto++;
+            if (archivoEsperado) fputc(objetivo, archivoEsperado);
+        }
+    }
+    
+    if (!error && enBloque > 0) {
+        error = !escribirTodo(destino, bloque, enBloque);
+        if (!error) bytes += enBloque;
+    }
+    
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    if (segundos <= 0) segundos = 1e-9;
+    
+    if (esclavo != -1) {
+        // No colgar antes de que el decodificador lea lo pendiente
+        if (!error) esperarLecturaPendiente(esclavo);
+        close(esclavo);
+    }
+    close(destino);
+    if (archivoEsperado) fclose(archivoEsperado);
+    
+    fprintf(stderr, "%ld tramas (%ld fragmentos), %ld bytes en %.3f s: %.0f tramas/s, %.0f bytes/s%s\n",
+            enviadas, fragmentos, bytes, segundos, enviadas / segundos, bytes / segundos,
+            error ? " (escritura interrumpida)" : "");
+    return error ? 1 : 0;
+}
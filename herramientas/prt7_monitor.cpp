@@ -0,0 +1,102 @@
+/**
+ * @file prt7_monitor.cpp
+ * @brief Lector del anillo compartido que publica el decodificador con --publicar
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Muestra en vivo el mensaje que se va decodificando, o cada evento del
+ * anillo, sin pasar por tuberías ni frenar al decodificador: el anillo se
+ * mapea de sólo lectura y se pueden abrir tantos monitores como se quiera.
+ *
+ * Uso:
+ *   prt7_monitor --anillo=NOMBRE [--desde-inicio] [--eventos]
+ *
+ * Espera a que el anillo exista y termina cuando el decodificador lo cierra.
+ * Al terminar, el decodificador borra el nombre de /dev/shm: un monitor
+ * abierto después espera a la siguiente corrida con el mismo --publicar.
+ * Con --desde-inicio empieza por el evento más antiguo que el anillo aún
+ * conserva; si no, sólo muestra lo que se publique después de abrirlo.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include "AnilloCompartido.h"
+
+/**
+ * @brief Muestra un evento en una línea: "N L crudo decodificado" o "N M rotor rotacion"
+ * @param evento Evento leído del anillo
+ */
+static void mostrarEvento(const EventoAnillo& evento) {
+    if (evento.tipo == EVENTO_FRAGMENTO) {
+        printf("%llu L %c %c\n", (unsigned long long)evento.secuencia, evento.crudo, evento.decodificado);
+    } else {
+        printf("%llu M %d %d\n", (unsigned long long)evento.secuencia, evento.rotor, evento.rotacion);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* nombre = nullptr;
+    bool desdeInicio = false;
+    bool eventos = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--anillo=", 9) == 0 && argv[i][9] != '\0') {
+            nombre = &argv[i][9];
+        } else if (strcmp(argv[i], "--desde-inicio") == 0) {
+            desdeInicio = true;
+        } else if (strcmp(argv[i], "--eventos") == 0) {
+            eventos = true;
+        } else {
+            nombre = nullptr;
+            break;
+        }
+    }
+    if (!nombre) {
+        fprintf(stderr, "Uso: %s --anillo=NOMBRE [--desde-inicio] [--eventos]\n", argv[0]);
+        return 1;
+    }
+
+    // El decodificador puede arrancar después que el monitor
+    LectorAnillo lector;
+    bool avisado = false;
+    while (!lector.abrir(nombre, desdeInicio)) {
+        if (!avisado) {
+            fprintf(stderr, "Esperando el anillo %s...\n", nombre);
+            avisado = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    fprintf(stderr, "Anillo %s abierto.\n", nombre);
+
+    unsigned long long fragmentos = 0;
+    unsigned long long rotaciones = 0;
+    bool cerrado = false;
+    EventoAnillo evento;
+    while (true) {
+        if (lector.siguiente(evento)) {
+            if (evento.tipo == EVENTO_FRAGMENTO) {
+                fragmentos++;
+                if (!eventos) putchar(evento.decodificado);
+            } else {
+                rotaciones++;
+            }
+            if (eventos) mostrarEvento(evento);
+            continue;
+        }
+
+        // Al ver el cierre queda una última pasada: el publicador marca
+        // 'cerrado' después de su último evento
+        if (cerrado) break;
+        fflush(stdout);
+        cerrado = lector.cerrado();
+        if (!cerrado) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if (!eventos) putchar('\n');
+    fflush(stdout);
+    fprintf(stderr, "Anillo cerrado: %llu fragmentos, %llu rotaciones, %llu eventos perdidos.\n",
+            fragmentos, rotaciones, (unsigned long long)lector.getPerdidos());
+    return 0;
+}
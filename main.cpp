@@ -11,221 +11,728 @@
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
-#include "TramaBase.h"
-#include "TramaLoad.h"
-#include "TramaMap.h"
+#include <csignal>
+#include "TramaValor.h"
+#include "ParserTramas.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
+#include "RotorAlfabeto.h"
+#include "DecodificadorLotes.h"
+#include "ArchivoCaptura.h"
+#include "PuertoSerial.h"
+#include "LectorMultipuerto.h"
+#include "MotorMultiflujo.h"
+#include "TuberiaDecodificacion.h"
+#include "LectorTramas.h"
+#include "ProtocoloBinario.h"
+#include "Instrumentacion.h"
+#include "PersistenciaEstado.h"
+#include "SumideroSalida.h"
+#include "CascadaRotores.h"
+#include "BusquedaIncremental.h"
+#include "ListaDeCargaDiferida.h"
+#include "EscritorAsincrono.h"
+#include "AnilloCompartido.h"
 
-#ifdef _WIN32
-    #include <windows.h>
-#else
-    #include <fcntl.h>
+#ifndef _WIN32
     #include <unistd.h>
-    #include <termios.h>
 #endif
 
 /**
- * @brief Abre el puerto serial según el sistema operativo
- * @param puerto Nombre del puerto (ej. "COM3" o "/dev/ttyUSB0")
- * @return Handle/descriptor del puerto o valor inválido si falla
+ * @brief Decodifica un lote de tramas y escribe el resultado en la salida
+ * @param decodificador Decodificador paralelo
+ * @param lote Tramas del lote
+ * @param n Cantidad de tramas
+ * @param rotor Rotor con el estado al inicio del lote; queda actualizado
+ * @param malformadas Se incrementa por cada MAP a un rotor distinto del 0,
+ *        que con un solo rotor no se aplica
+ * @return Cantidad de fragmentos escritos
  */
-#ifdef _WIN32
-HANDLE abrirPuertoSerial(const char* puerto) {
-    HANDLE hSerial = CreateFileA(puerto, GENERIC_READ, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+long escribirLote(DecodificadorLotes& decodificador, const TramaValor* lote, long n,
+                  RotorDeMapeo* rotor, long& malformadas) {
+    for (long i = 0; i < n; i++) {
+        if (lote[i].tipo == TRAMA_MAP && lote[i].rotor != 0) {
+            malformadas++;
+            PRT7_CONTAR(CONTADOR_MALFORMADAS, 1);
+        }
+    }
     
-    if (hSerial == INVALID_HANDLE_VALUE) {
-        return INVALID_HANDLE_VALUE;
+    int k = decodificador.calcularSegmentos(n);
+    ListaDeCarga* segmentos = new ListaDeCarga[k];
+    for (int t = 0; t < k; t++) {
+        segmentos[t].configurarProgreso(PROGRESO_APAGADO);
     }
     
-    DCB dcbSerialParams = {0};
-    dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
+    k = decodificador.decodificarSegmentos(lote, n, rotor, segmentos);
     
-    if (!GetCommState(hSerial, &dcbSerialParams)) {
-        CloseHandle(hSerial);
-        return INVALID_HANDLE_VALUE;
+    long fragmentos = 0;
+    for (int t = 0; t < k; t++) {
+        segmentos[t].escribirMensaje(std::cout);
+        fragmentos += segmentos[t].getLongitud();
     }
     
-    dcbSerialParams.BaudRate = CBR_9600;
-    dcbSerialParams.ByteSize = 8;
-    dcbSerialParams.StopBits = ONESTOPBIT;
-    dcbSerialParams.Parity = NOPARITY;
+    delete[] segmentos;
+    return fragmentos;
+}
+
+/**
+ * @brief Decodifica un archivo de captura mapeado en memoria
+ * @param captura Archivo ya mapeado
+ * @param rotor Rotor de mapeo
+ * @param tramas Total de tramas válidas procesadas
+ * @param malformadas Total de líneas no reconocidas
+ * @return Cantidad de fragmentos decodificados
+ *
+ * Las líneas se parsean en el lugar, sin copiarlas, y se agrupan en lotes
+ * que se decodifican en paralelo. Si el archivo empieza con PRT7_SINCRONIA
+ * se interpreta como una captura en formato binario. Cada lote se escribe apenas termina, así
+ * que la memoria no depende del tamaño del archivo.
+ */
+long decodificarCaptura(const ArchivoCaptura& captura, RotorDeMapeo* rotor,
+                        long& tramas, long& malformadas) {
+    const long TRAMAS_POR_LOTE = 1L << 16;
+    TramaValor* lote = new TramaValor[TRAMAS_POR_LOTE];
+    DecodificadorLotes decodificador;
+    long enLote = 0;
+    long fragmentos = 0;
+    tramas = 0;
+    malformadas = 0;
+    
+    const char* actual = captura.getDatos();
+    const char* fin = actual + captura.getTamano();
+    
+    if (actual < fin && (unsigned char)*actual == PRT7_SINCRONIA) {
+        // Captura en formato binario: no hay líneas que separar
+        DecodificadorBinario binario;
+        for (; actual < fin; actual++) {
+            if (!binario.empujar((unsigned char)*actual, lote[enLote])) continue;
+            enLote++;
+            tramas++;
+            if (enLote == TRAMAS_POR_LOTE) {
+                fragmentos += escribirLote(decodificador, lote, enLote, rotor, malformadas);
+                enLote = 0;
+            }
+        }
+        malformadas += binario.getMalformadas();
+    }
     
-    if (!SetCommState(hSerial, &dcbSerialParams)) {
-        CloseHandle(hSerial);
-        return INVALID_HANDLE_VALUE;
+    // El parser recibe longitudes long (32 bits en Windows): capturas de más
+    // de 2 GB se entregan por tramos
+    const long MAX_TRAMO = 1L << 30;
+    while (actual < fin) {
+        long tramo = (fin - actual) > MAX_TRAMO ? MAX_TRAMO : (long)(fin - actual);
+        long consumidos;
+        long nuevas = parsearBloqueTramas(actual, tramo, lote + enLote,
+                                          TRAMAS_POR_LOTE - enLote, consumidos, malformadas);
+        enLote += nuevas;
+        tramas += nuevas;
+        actual += consumidos;
+        
+        if (enLote == TRAMAS_POR_LOTE) {
+            fragmentos += escribirLote(decodificador, lote, enLote, rotor, malformadas);
+            enLote = 0;
+        } else if (actual + (tramo - consumidos) == fin) {
+            break; // Sin más saltos de línea en la captura
+        } else if (consumidos == 0) {
+            // Una línea que ocupa todo el tramo no puede ser una trama: se
+            // descarta hasta el próximo salto, como en EnsambladorLineas
+            malformadas++;
+            PRT7_CONTAR(CONTADOR_MALFORMADAS, 1);
+            const char* salto = (const char*)memchr(actual + tramo, '\n', (size_t)(fin - actual - tramo));
+            actual = salto ? salto + 1 : fin;
+        }
     }
     
-    COMMTIMEOUTS timeouts = {0};
-    timeouts.ReadIntervalTimeout = 50;
-    timeouts.ReadTotalTimeoutConstant = 50;
-    timeouts.ReadTotalTimeoutMultiplier = 10;
+    // La última línea puede no tener salto final
+    if (actual < fin) {
+        long longitud = fin - actual;
+        if (actual[longitud - 1] == '\r') longitud--;
+        if (longitud > 0) {
+            if (parsearTramaValor(actual, longitud, lote[enLote])) {
+                enLote++;
+                tramas++;
+            } else {
+                malformadas++;
+                PRT7_CONTAR(CONTADOR_MALFORMADAS, 1);
+            }
+        }
+    }
     
-    SetCommTimeouts(hSerial, &timeouts);
+    fragmentos += escribirLote(decodificador, lote, enLote, rotor, malformadas);
+    std::cout << std::endl;
+    PRT7_CONTAR(CONTADOR_BYTES, captura.getTamano());
+    PRT7_CONTAR(CONTADOR_TRAMAS, tramas);
     
-    return hSerial;
+    delete[] lote;
+    return fragmentos;
 }
-#else
-int abrirPuertoSerial(const char* puerto) {
-    int fd = open(puerto, O_RDONLY | O_NOCTTY);
+
+/**
+ * @brief Decodifica un archivo de captura completo y termina
+ * @param rutaCaptura Ruta del archivo
+ * @return Código de salida del programa
+ */
+int modoCaptura(const char* rutaCaptura) {
+    std::cout << "Iniciando Decodificador PRT-7. Leyendo captura " << rutaCaptura << "..." << std::endl;
+    
+    ArchivoCaptura captura;
+    if (!captura.abrir(rutaCaptura)) {
+        std::cout << "No se pudo abrir el archivo de captura." << std::endl;
+        return 1;
+    }
+    
+    RotorDeMapeo rotor;
+    long tramas = 0;
+    long malformadas = 0;
+    std::cout << "MENSAJE OCULTO ENSAMBLADO:" << std::endl;
+    long fragmentos = decodificarCaptura(captura, &rotor, tramas, malformadas);
+    
+    std::cout << "---" << std::endl;
+    std::cout << "Flujo de datos terminado. " << tramas << " tramas, " << fragmentos
+              << " fragmentos, " << malformadas << " lineas mal formadas." << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Bandera que el manejador de SIGINT activa para detener la lectura
+ */
+static volatile std::sig_atomic_t detenerLectura = 0;
+
+/**
+ * @brief Manejador de SIGINT que pide terminar el bucle de lectura
+ * @param senal Número de señal recibida
+ */
+static void manejarInterrupcion(int senal) {
+    (void)senal;
+    detenerLectura = 1;
+}
+
+/**
+ * @brief Vigila varios puertos a la vez, cada uno con su propio estado
+ * @param listaPuertos Rutas separadas por comas (se modifica con strtok)
+ * @param configuracion Velocidad y VMIN/VTIME, iguales para todos los puertos
+ * @param hilos Hilos del motor que decodifica los puertos (0 = en este hilo)
+ */
+int modoMultipuerto(char* listaPuertos, const ConfiguracionSerial& configuracion, int hilos) {
+    std::cout << "Iniciando Decodificador PRT-7. Conectando a varios puertos..." << std::endl;
     
-    if (fd == -1) {
-        return -1;
+    LectorMultipuerto lector;
+    for (char* ruta = strtok(listaPuertos, ","); ruta; ruta = strtok(nullptr, ",")) {
+        if (lector.agregar(ruta, configuracion)) {
+            std::cout << "Conexion establecida con " << ruta << "." << std::endl;
+        } else {
+            std::cout << "No se pudo abrir " << ruta << "." << std::endl;
+        }
     }
     
-    struct termios options;
-    tcgetattr(fd, &options);
+    if (lector.getNumDispositivos() == 0) {
+        std::cout << "No hay puertos disponibles." << std::endl;
+        return 1;
+    }
     
-    cfsetispeed(&options, B9600);
-    options.c_cflag |= (CLOCAL | CREAD);
-    options.c_cflag &= ~PARENB;
-    options.c_cflag &= ~CSTOPB;
-    options.c_cflag &= ~CSIZE;
-    options.c_cflag |= CS8;
+    // Con --hilos este hilo sólo lee: cada puerto es un flujo del motor
+    MotorMultiflujo* motor = nullptr;
+    if (hilos > 0) {
+        motor = new MotorMultiflujo(hilos);
+        lector.usarMotor(motor);
+        std::cout << "Decodificando en " << motor->getNumTrabajadores() << " hilos." << std::endl;
+    }
     
-    tcsetattr(fd, TCSANOW, &options);
+    std::cout << "Esperando tramas... (Ctrl+C para terminar)" << std::endl;
+    std::signal(SIGINT, manejarInterrupcion);
+    lector.ejecutar(&detenerLectura);
+    if (motor) motor->detener();
     
-    return fd;
+    std::cout << std::endl << "---" << std::endl;
+    std::cout << "Flujo de datos terminado." << std::endl;
+    for (int i = 0; i < lector.getNumDispositivos(); i++) {
+        const DispositivoSerial& dispositivo = lector.getDispositivo(i);
+        const SesionFlujo* sesion = motor ? motor->buscarSesion(dispositivo.id) : nullptr;
+        std::cout << "MENSAJE OCULTO ENSAMBLADO [" << dispositivo.ruta << "] ("
+                  << dispositivo.tramas << " tramas, " << dispositivo.lector.getMalformadas()
+                  << " lineas mal formadas):" << std::endl;
+        (sesion ? sesion->carga : dispositivo.carga).escribirMensaje(std::cout);
+        std::cout << std::endl;
+    }
+    std::cout << "---" << std::endl;
+    delete motor;
+    return 0;
 }
-#endif
 
 /**
- * @brief Lee una línea del puerto serial
- * @param handle Handle/descriptor del puerto
- * @param buffer Buffer donde se almacenará la línea
- * @param maxLen Tamaño máximo del buffer
- * @return true si se leyó una línea completa, false si no
+ * @struct PuertoTramas
+ * @brief Puerto abierto junto con el lector que detecta su formato
  */
+struct PuertoTramas {
 #ifdef _WIN32
-bool leerLineaSerial(HANDLE hSerial, char* buffer, int maxLen) {
-    static char bufferInterno[256];
-    static int posBuffer = 0;
-    static int bytesDisponibles = 0;
+    HANDLE handle;        ///< Handle del puerto
+#else
+    int handle;           ///< Descriptor del puerto
+#endif
+    LectorTramas lector;  ///< Tramas armadas a partir de los bytes leídos
+    PersistenciaEstado* persistencia; ///< Diario a vaciar antes de esperar datos (puede ser nullptr)
+#ifdef PRT7_INSTRUMENTACION
+    unsigned long long llegada; ///< Instante de la última lectura con datos
+#endif
+};
+
+/**
+ * @brief Lee la siguiente trama del puerto, en texto o en binario
+ * @param contexto Puntero a un PuertoTramas
+ * @param trama Trama leída
+ * @return false cuando el puerto se cerró o falló
+ *
+ * Cumple con la interfaz FuenteTramas de la tubería.
+ */
+static bool leerTramaPuerto(void* contexto, TramaValor& trama) {
+    PuertoTramas* puerto = static_cast<PuertoTramas*>(contexto);
     
     while (true) {
-        if (posBuffer < bytesDisponibles) {
-            for (int i = posBuffer; i < bytesDisponibles; i++) {
-                if (bufferInterno[i] == '\n') {
-                    int longitud = i - posBuffer;
-                    if (longitud > 0 && bufferInterno[i-1] == '\r') longitud--;
-                    
-                    if (longitud > 0 && longitud < maxLen) {
-                        for (int j = 0; j < longitud; j++) {
-                            buffer[j] = bufferInterno[posBuffer + j];
-                        }
-                        buffer[longitud] = '\0';
-                        posBuffer = i + 1;
-                        return true;
-                    }
-                    posBuffer = i + 1;
-                }
-            }
+        PRT7_MARCA(inicioParseo);
+        if (puerto->lector.siguiente(trama)) {
+            PRT7_MEDIR(ETAPA_PARSEO, inicioParseo);
+            return true;
         }
         
-        posBuffer = 0;
-        DWORD bytesLeidos;
-        if (!ReadFile(hSerial, bufferInterno, sizeof(bufferInterno) - 1, &bytesLeidos, NULL)) {
-            return false;
-        }
+        // Todo lo recibido queda en el diario antes de bloquearse en el puerto
+        if (puerto->persistencia) puerto->persistencia->vaciar();
         
-        if (bytesLeidos == 0) {
+        int disponible;
+        char* destino = puerto->lector.espacioLibre(disponible);
+        PRT7_MARCA(inicioLectura);
+        long leidos = leerBytesSerial(puerto->handle, destino, disponible);
+        if (leidos <= 0) {
             return false;
         }
-        
-        bytesDisponibles = bytesLeidos;
-        bufferInterno[bytesLeidos] = '\0';
+        PRT7_MEDIR(ETAPA_LECTURA, inicioLectura);
+        PRT7_CONTAR(CONTADOR_BYTES, leidos);
+#ifdef PRT7_INSTRUMENTACION
+        puerto->llegada = instrumentacionAhora();
+#endif
+        puerto->lector.confirmar((int)leidos);
     }
 }
-#else
-bool leerLineaSerial(int fd, char* buffer, int maxLen) {
-    static char bufferInterno[256];
-    static int posBuffer = 0;
-    static int bytesDisponibles = 0;
-    
-    while (true) {
-        if (posBuffer < bytesDisponibles) {
-            for (int i = posBuffer; i < bytesDisponibles; i++) {
-                if (bufferInterno[i] == '\n') {
-                    int longitud = i - posBuffer;
-                    if (longitud > 0 && bufferInterno[i-1] == '\r') longitud--;
-                    
-                    if (longitud > 0 && longitud < maxLen) {
-                        for (int j = 0; j < longitud; j++) {
-                            buffer[j] = bufferInterno[posBuffer + j];
-                        }
-                        buffer[longitud] = '\0';
-                        posBuffer = i + 1;
-                        return true;
-                    }
-                    posBuffer = i + 1;
-                }
+
+/**
+ * @struct DestinoTramas
+ * @brief Estructuras que actualiza cada trama en el modo de un puerto
+ */
+struct DestinoTramas {
+    ListaDeCarga* carga;              ///< Lista de carga
+    RotorDeMapeo* rotor;              ///< Rotor de mapeo
+    CascadaRotores* cascada;          ///< Cadena de rotores que reemplaza al rotor, o nullptr
+    RotorImprimible* imprimible;      ///< Rotor que reemplaza al rotor con --alfabeto=imprimible, o nullptr
+    ListaDeCargaDiferida* diferida;   ///< Lista que reemplaza a la carga con --diferido, o nullptr
+    PersistenciaEstado* persistencia; ///< Estado en disco o nullptr
+    BusquedaIncremental* busqueda;    ///< Texto a vigilar en el mensaje o nullptr
+    PublicadorAnillo* publicador;     ///< Anillo compartido donde se publica cada trama o nullptr
+};
+
+/**
+ * @brief Aplica una trama y, si hay persistencia, la agrega al diario
+ * @param trama Trama a aplicar
+ * @param destino Estructuras a actualizar
+ */
+static void aplicarTrama(const TramaValor& trama, const DestinoTramas& destino) {
+    if (destino.publicador) {
+        // Se publica con los rotores previos a la trama, que son los que la decodifican
+        if (trama.tipo == TRAMA_LOAD) {
+            char decodificado = destino.cascada ? destino.cascada->getMapeo(trama.caracter)
+                              : destino.imprimible ? destino.imprimible->getMapeo(trama.caracter)
+                                                   : destino.rotor->getMapeo(trama.caracter);
+            destino.publicador->publicarFragmento(trama.caracter, decodificado);
+        } else if (trama.tipo == TRAMA_MAP) {
+            // Sólo se publica la rotación que los despachos van a aplicar
+            int numRotores = destino.cascada ? destino.cascada->getNumRotores() : 1;
+            if (trama.rotor < numRotores) {
+                destino.publicador->publicarRotacion(trama.rotor, trama.rotacion);
             }
         }
-        
-        posBuffer = 0;
-        int bytesLeidos = read(fd, bufferInterno, sizeof(bufferInterno) - 1);
-        
-        if (bytesLeidos <= 0) {
-            return false;
-        }
-        
-        bytesDisponibles = bytesLeidos;
-        bufferInterno[bytesLeidos] = '\0';
+    }
+    if (destino.diferida) {
+        despacharTramaDiferida(trama, destino.diferida, destino.rotor);
+        return;
+    }
+    if (destino.cascada) {
+        despacharTramaCascada(trama, destino.carga, destino.cascada);
+    } else if (destino.imprimible) {
+        despacharTrama(trama, destino.carga, destino.imprimible);
+    } else {
+        despacharTrama(trama, destino.carga, destino.rotor);
+        if (destino.persistencia) destino.persistencia->registrar(trama, *destino.carga, *destino.rotor);
+    }
+    
+    // Sólo se revisa lo que agregó esta trama
+    long posicion;
+    while (destino.busqueda && destino.busqueda->siguiente(*destino.carga, posicion)) {
+        std::cout << "Coincidencia de \"" << destino.busqueda->getPatron() << "\" en la posicion "
+                  << posicion << ".\n";
     }
 }
-#endif
 
 /**
- * @brief Parsea una línea y crea la trama correspondiente
- * @param linea Línea leída del puerto serial
- * @return Puntero a la trama creada o nullptr si hay error
+ * @brief Procesa el puerto con la tubería de tres hilos y muestra sus colas
+ * @param puerto Puerto con su lector de tramas
+ * @param carga Lista de carga
+ * @param rotor Rotor de mapeo
+ * @param modo Modo de progreso
+ * @param k Tamaño de la ventana de progreso
  */
-TramaBase* parsearTrama(char* linea) {
-    if (!linea || linea[0] == '\0') return nullptr;
+void procesarConTuberia(PuertoTramas* puerto, ListaDeCarga* carga, RotorDeMapeo* rotor, ModoProgreso modo, int k) {
+    TuberiaDecodificacion tuberia(carga, rotor, modo, k);
+    tuberia.ejecutar(leerTramaPuerto, puerto);
     
-    // Parsear tipo de trama
-    char tipo = linea[0];
-    
-    if (linea[1] != ',') return nullptr;
-    
-    if (tipo == 'L') {
-        // Trama LOAD: L,X
-        char caracter = linea[2];
-        if (caracter == '\0') return nullptr;
-        
-        // Manejar caso especial de "Space"
-        if (linea[2] == 'S' && linea[3] == 'p' && linea[4] == 'a' && 
-            linea[5] == 'c' && linea[6] == 'e') {
-            caracter = ' ';
+    std::cout << std::endl << "Tuberia: " << tuberia.getTramas() << " tramas ("
+              << puerto->lector.getMalformadas() << " mal formadas). Profundidad maxima de colas: tramas "
+              << tuberia.getMaximoTramas() << ", salida " << tuberia.getMaximoSalida() << "." << std::endl;
+}
+
+/**
+ * @brief Interpreta la opción --progreso=MODO
+ * @param valor Texto después del '=' (apagado, completo o ventana[:K])
+ * @param modo Modo resultante
+ * @param k Tamaño de ventana resultante
+ * @return true si el valor es válido
+ */
+bool parsearModoProgreso(const char* valor, ModoProgreso& modo, int& k) {
+    if (strcmp(valor, "apagado") == 0) {
+        modo = PROGRESO_APAGADO;
+    } else if (strcmp(valor, "completo") == 0) {
+        modo = PROGRESO_COMPLETO;
+    } else if (strncmp(valor, "ventana", 7) == 0) {
+        modo = PROGRESO_VENTANA;
+        k = 16;
+        if (valor[7] == ':') {
+            long ventana;
+            if (!leerEntero(&valor[8], 1, 1 << 20, ventana)) return false;
+            k = (int)ventana;
+        } else if (valor[7] != '\0') {
+            return false;
         }
-        
-        return new TramaLoad(caracter);
-    } 
-    else if (tipo == 'M') {
-        // Trama MAP: M,N
-        int rotacion = atoi(&linea[2]);
-        return new TramaMap(rotacion);
+    } else {
+        return false;
     }
-    
-    return nullptr;
+    return true;
+}
+
+/**
+ * @brief Interpreta el valor de --alfabeto
+ * @param valor Texto después del '=' (mayusculas o imprimible)
+ * @param alfabeto Alfabeto resultante
+ * @return true si el valor es válido
+ */
+bool parsearAlfabeto(const char* valor, AlfabetoTramas& alfabeto) {
+    if (strcmp(valor, "mayusculas") == 0) {
+        alfabeto = ALFABETO_MAYUSCULAS;
+    } else if (strcmp(valor, "imprimible") == 0) {
+        alfabeto = ALFABETO_IMPRIMIBLE;
+    } else {
+        return false;
+    }
+    return true;
 }
 
 /**
  * @brief Función principal del programa
+ * @param argc Número de argumentos
+ * @param argv Argumentos: --progreso=apagado|completo|ventana[:K], --memoria y
+ *             --captura=RUTA para decodificar un archivo en lugar del puerto y
+ *             --puertos=RUTA1,RUTA2,... para vigilar varios puertos a la vez y
+ *             --hilos=N para decodificar esos puertos en N hilos y
+ *             --tuberia para leer, decodificar y mostrar en hilos separados y
+ *             --puerto=RUTA para usar otro puerto (ej. el del generador) y
+ *             --estado=RUTA para guardar y recuperar el estado entre ejecuciones y
+ *             --flujo=RUTA (o '-' para la consola, con --progreso=apagado) con --retener=N para escribir
+ *             el mensaje por bloques conservando sólo N fragmentos en memoria y
+ *             --rotores=N para decodificar con una cadena de N rotores ("M,R,N") y
+ *             --alfabeto=imprimible para rotar también minúsculas, dígitos y signos y
+ *             --buscar=TEXTO para avisar cada aparición de TEXTO mientras se decodifica y
+ *             --diferido para guardar los fragmentos crudos y decodificarlos al final y
+ *             --publicar=NOMBRE para publicar cada trama en un anillo de /dev/shm y
+ *             --baudios=N, --vmin=N, --vtime=N y --baja-latencia para la línea serial,
+ *             o --config-serial=RUTA con esas opciones (y puerto=RUTA) en un archivo
  */
-int main() {
+int main(int argc, char* argv[]) {
+    PRT7_INSTALAR_INSTRUMENTACION();
+    
+    // La consola la escribe un hilo aparte: el progreso por trama no hace
+    // una llamada al sistema por trama. Se vacía al salir de main()
+    SumideroDescriptor consola(1);
+    EscritorAsincrono salidaConsola(&consola);
+    salidaConsola.instalar(std::cout);
+    
+    ModoProgreso modoProgreso = PROGRESO_COMPLETO;
+    int ventanaProgreso = 0;
+    bool progresoElegido = false;
+    bool reportarMemoria = false;
+    const char* rutaCaptura = nullptr;
+    char* listaPuertos = nullptr;
+    int hilosPuertos = 0;
+    bool usarTuberia = false;
+    ConfiguracionSerial configuracionSerial;
+    const char* rutaEstado = nullptr;
+    const char* rutaFlujo = nullptr;
+    long retenerFlujo = 4096;
+    int numRotores = 1;
+    AlfabetoTramas alfabeto = ALFABETO_MAYUSCULAS;
+    const char* textoBuscado = nullptr;
+    bool usarDiferida = false;
+    const char* nombreAnillo = nullptr;
+    
+    // El archivo de configuración serial se lee primero: las opciones de la
+    // línea de comandos tienen prioridad sin importar el orden
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--config-serial=", 16) != 0) continue;
+        int lineaError;
+        if (!cargarConfiguracionSerial(&argv[i][16], configuracionSerial, lineaError)) {
+            if (lineaError == 0) {
+                std::cout << "No se pudo leer " << &argv[i][16] << "." << std::endl;
+            } else {
+                std::cout << "Opcion serial invalida en " << &argv[i][16] << ", linea " << lineaError << "." << std::endl;
+            }
+            return 1;
+        }
+    }
+    
+    long numero;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--progreso=", 11) == 0 &&
+            parsearModoProgreso(&argv[i][11], modoProgreso, ventanaProgreso)) {
+            progresoElegido = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--memoria") == 0) {
+            reportarMemoria = true;
+            continue;
+        }
+        if (strncmp(argv[i], "--captura=", 10) == 0 && argv[i][10] != '\0') {
+            rutaCaptura = &argv[i][10];
+            continue;
+        }
+        if (strncmp(argv[i], "--puertos=", 10) == 0 && argv[i][10] != '\0') {
+            listaPuertos = &argv[i][10];
+            continue;
+        }
+        if (strncmp(argv[i], "--hilos=", 8) == 0 && leerEntero(&argv[i][8], 1, 1024, numero)) {
+            hilosPuertos = (int)numero;
+            continue;
+        }
+        if (strcmp(argv[i], "--tuberia") == 0) {
+            usarTuberia = true;
+            continue;
+        }
+        if (strncmp(argv[i], "--puerto=", 9) == 0 &&
+            asignarOpcionSerial(configuracionSerial, "puerto", &argv[i][9])) {
+            continue;
+        }
+        if (strncmp(argv[i], "--baudios=", 10) == 0 &&
+            asignarOpcionSerial(configuracionSerial, "baudios", &argv[i][10])) {
+            continue;
+        }
+        if (strncmp(argv[i], "--vmin=", 7) == 0 &&
+            asignarOpcionSerial(configuracionSerial, "vmin", &argv[i][7])) {
+            continue;
+        }
+        if (strncmp(argv[i], "--vtime=", 8) == 0 &&
+            asignarOpcionSerial(configuracionSerial, "vtime", &argv[i][8])) {
+            continue;
+        }
+        if (strcmp(argv[i], "--baja-latencia") == 0) {
+            configuracionSerial.bajaLatencia = true;
+            continue;
+        }
+        if (strncmp(argv[i], "--config-serial=", 16) == 0) {
+            continue;
+        }
+        if (strncmp(argv[i], "--estado=", 9) == 0 && argv[i][9] != '\0') {
+            rutaEstado = &argv[i][9];
+            continue;
+        }
+        if (strncmp(argv[i], "--flujo=", 8) == 0 && argv[i][8] != '\0') {
+            rutaFlujo = &argv[i][8];
+            continue;
+        }
+        if (strncmp(argv[i], "--retener=", 10) == 0 && leerEntero(&argv[i][10], 0, 1L << 30, numero)) {
+            retenerFlujo = numero;
+            continue;
+        }
+        if (strncmp(argv[i], "--rotores=", 10) == 0 &&
+            leerEntero(&argv[i][10], 1, CascadaRotores::MAX_ROTORES, numero)) {
+            numRotores = (int)numero;
+            continue;
+        }
+        if (strncmp(argv[i], "--alfabeto=", 11) == 0 && parsearAlfabeto(&argv[i][11], alfabeto)) {
+            continue;
+        }
+        if (strncmp(argv[i], "--buscar=", 9) == 0 && argv[i][9] != '\0') {
+            textoBuscado = &argv[i][9];
+            continue;
+        }
+        if (strcmp(argv[i], "--diferido") == 0) {
+            usarDiferida = true;
+            continue;
+        }
+        if (strncmp(argv[i], "--publicar=", 11) == 0 && argv[i][11] != '\0') {
+            nombreAnillo = &argv[i][11];
+            continue;
+        }
+        std::cout << "Uso: " << argv[0] << " [--progreso=apagado|completo|ventana[:K]] [--memoria]"
+                  << " [--captura=RUTA] [--puertos=RUTA1,RUTA2,...] [--hilos=N] [--tuberia] [--puerto=RUTA]"
+                  << " [--estado=RUTA] [--flujo=RUTA|-] [--retener=N] [--rotores=N]"
+                  << " [--alfabeto=mayusculas|imprimible]"
+                  << " [--buscar=TEXTO] [--diferido] [--publicar=NOMBRE]"
+                  << " [--baudios=N] [--vmin=1..255] [--vtime=0..255] [--baja-latencia]"
+                  << " [--config-serial=RUTA]" << std::endl;
+        return 1;
+    }
+    
+    if (hilosPuertos > 0 && !listaPuertos) {
+        std::cout << "--hilos solo se puede usar con --puertos." << std::endl;
+        return 1;
+    }
+    if (rutaEstado && usarTuberia) {
+        std::cout << "--estado no se puede combinar con --tuberia." << std::endl;
+        return 1;
+    }
+    if (rutaEstado && rutaFlujo) {
+        std::cout << "--estado no se puede combinar con --flujo." << std::endl;
+        return 1;
+    }
+    if (rutaFlujo && strcmp(rutaFlujo, "-") == 0 && (!progresoElegido || modoProgreso != PROGRESO_APAGADO)) {
+        // Los bloques del mensaje y los registros de progreso se mezclarían en la consola
+        std::cout << "--flujo=- solo se puede usar con --progreso=apagado." << std::endl;
+        return 1;
+    }
+    
+    if (numRotores > 1 && (usarTuberia || rutaEstado || rutaCaptura || listaPuertos)) {
+        // Esos modos guardan o reparten un único desplazamiento de rotor
+        std::cout << "--rotores solo se puede usar con un puerto y sin --tuberia ni --estado." << std::endl;
+        return 1;
+    }
+    if (alfabeto == ALFABETO_IMPRIMIBLE && (usarTuberia || rutaEstado || rutaCaptura || listaPuertos ||
+                                            usarDiferida || numRotores > 1)) {
+        // La tubería, el estado, la captura y los lotes sólo conocen el rotor A-Z
+        std::cout << "--alfabeto=imprimible solo se puede usar con un puerto y un rotor, sin --tuberia,"
+                  << " --estado ni --diferido." << std::endl;
+        return 1;
+    }
+    if (textoBuscado && (usarTuberia || rutaCaptura || listaPuertos)) {
+        // Esos modos no conservan el mensaje en una lista de este hilo
+        std::cout << "--buscar solo se puede usar con un puerto y sin --tuberia." << std::endl;
+        return 1;
+    }
+    
+    if (nombreAnillo && (usarTuberia || rutaCaptura || listaPuertos)) {
+        // El anillo tiene un único escritor: el hilo que aplica las tramas
+        std::cout << "--publicar solo se puede usar con un puerto y sin --tuberia." << std::endl;
+        return 1;
+    }
+    
+    if (rutaCaptura && (usarTuberia || rutaEstado || rutaFlujo || reportarMemoria || listaPuertos)) {
+        // La captura se decodifica por lotes y se escribe al terminar cada uno
+        std::cout << "--captura no se puede combinar con --tuberia, --estado, --flujo, --memoria"
+                  << " ni --puertos." << std::endl;
+        return 1;
+    }
+    
+    if (usarDiferida && (usarTuberia || rutaEstado || rutaFlujo || rutaCaptura || listaPuertos ||
+                         numRotores > 1 || textoBuscado)) {
+        std::cout << "--diferido solo se puede usar con un puerto y un rotor, sin --tuberia,"
+                  << " --estado, --flujo ni --buscar." << std::endl;
+        return 1;
+    }
+    if (usarDiferida && progresoElegido && modoProgreso != PROGRESO_APAGADO) {
+        // Mostrar cada fragmento obligaría a decodificarlo al llegar
+        std::cout << "--diferido no muestra progreso por trama; use --progreso=apagado." << std::endl;
+        return 1;
+    }
+    
+    if (rutaCaptura) {
+        return modoCaptura(rutaCaptura);
+    }
+    if (listaPuertos) {
+        return modoMultipuerto(listaPuertos, configuracionSerial, hilosPuertos);
+    }
+    
     std::cout << "Iniciando Decodificador PRT-7. Conectando a puerto COM..." << std::endl;
     
     // Inicializar estructuras
     ListaDeCarga miListaDeCarga;
     RotorDeMapeo miRotorDeMapeo;
+    RotorImprimible miRotorImprimible;
+    CascadaRotores miCascada(numRotores);
+    CascadaRotores* cascada = numRotores > 1 ? &miCascada : nullptr;
+    ListaDeCargaDiferida miListaDiferida;
+    if (usarDiferida) modoProgreso = PROGRESO_APAGADO;
+    
+    // Recuperar el estado anterior: instantánea más la cola del diario
+    PersistenciaEstado estado;
+    PersistenciaEstado* persistencia = nullptr;
+    if (rutaEstado) {
+        if (!estado.abrir(rutaEstado, &miListaDeCarga, &miRotorDeMapeo)) {
+            std::cout << "No se pudo usar el estado en " << rutaEstado << "." << std::endl;
+            return 1;
+        }
+        persistencia = &estado;
+        std::cout << "Estado recuperado: " << miListaDeCarga.getLongitud() << " fragmentos, "
+                  << estado.getTramasReaplicadas() << " tramas reaplicadas del diario";
+        if (estado.getHuboHueco()) std::cout << " (faltaban tramas: el mensaje puede estar incompleto)";
+        std::cout << "." << std::endl;
+    }
+    
+    // Modo flujo: el mensaje sale por bloques y la memoria queda acotada
+    SumideroSalida* sumidero = nullptr;
+    if (rutaFlujo) {
+        if (strcmp(rutaFlujo, "-") == 0) {
+            sumidero = new SumideroFlujo(std::cout);
+        } else {
+            SumideroArchivo* archivo = new SumideroArchivo(rutaFlujo);
+            if (!archivo->estaAbierto()) {
+                std::cout << "No se pudo crear " << rutaFlujo << "." << std::endl;
+                delete archivo;
+                return 1;
+            }
+            sumidero = archivo;
+        }
+        miListaDeCarga.configurarFlujo(sumidero, retenerFlujo);
+        
+        // El progreso completo crecería con el mensaje: por omisión se usa una ventana
+        if (!progresoElegido) {
+            modoProgreso = PROGRESO_VENTANA;
+            ventanaProgreso = 16;
+        }
+    }
+    miListaDeCarga.configurarProgreso(modoProgreso, ventanaProgreso);
+    BusquedaIncremental* busqueda = textoBuscado ? new BusquedaIncremental(textoBuscado) : nullptr;
+    
+    DestinoTramas destino;
+    destino.carga = &miListaDeCarga;
+    destino.rotor = &miRotorDeMapeo;
+    destino.cascada = cascada;
+    destino.imprimible = alfabeto == ALFABETO_IMPRIMIBLE ? &miRotorImprimible : nullptr;
+    destino.diferida = usarDiferida ? &miListaDiferida : nullptr;
+    destino.persistencia = persistencia;
+    destino.busqueda = busqueda;
+    destino.publicador = nullptr;
+    
+    // Los lectores (paneles, alertas) abren el anillo por su nombre con prt7_monitor
+    PublicadorAnillo anillo;
+    if (nombreAnillo) {
+        if (!anillo.crear(nombreAnillo)) {
+            std::cout << "No se pudo crear el anillo compartido " << nombreAnillo << "." << std::endl;
+            delete busqueda;
+            delete sumidero;
+            return 1;
+        }
+        destino.publicador = &anillo;
+    }
     
     // Intentar abrir puerto serial
-    const char* nombrePuerto;
+    const char* nombrePuerto = configuracionSerial.getRuta();
+    bool bajaLatencia = false;
     
     #ifdef _WIN32
-        nombrePuerto = "\\\\.\\COM3"; // Cambiar según necesidad
-        HANDLE hSerial = abrirPuertoSerial(nombrePuerto);
+        HANDLE hSerial = abrirPuertoSerial(nombrePuerto, configuracionSerial, &bajaLatencia);
         
         if (hSerial == INVALID_HANDLE_VALUE) {
             std::cout << "No se pudo abrir el puerto serial. Usando modo de prueba con datos simulados." << std::endl;
@@ -237,33 +744,48 @@ int main() {
                 "L,W", "M,-2", "L,O", "L,R", "L,L", "L,D", nullptr
             };
             
+            // Las tramas de prueba no van al diario: repetirlas en cada
+            // ejecución con --estado agregaría el mismo mensaje cada vez
+            DestinoTramas simulado = destino;
+            simulado.persistencia = nullptr;
+            TramaValor trama;
             for (int i = 0; tramasPrueba[i] != nullptr; i++) {
-                char buffer[256];
-                strcpy(buffer, tramasPrueba[i]);
-                
-                TramaBase* trama = parsearTrama(buffer);
-                if (trama) {
-                    trama->procesar(&miListaDeCarga, &miRotorDeMapeo);
-                    delete trama;
+                if (parsearTramaValor(tramasPrueba[i], trama)) {
+                    aplicarTrama(trama, simulado);
                 }
             }
         } else {
-            std::cout << "Conexion establecida. Esperando tramas..." << std::endl << std::endl;
+            std::cout << "Conexion establecida a " << configuracionSerial.baudios << " baudios. Esperando tramas..."
+                      << std::endl << std::endl;
+            if (configuracionSerial.bajaLatencia && !bajaLatencia) {
+                std::cout << "El controlador de " << nombrePuerto << " no admite baja latencia; se sigue sin ella."
+                          << std::endl;
+            }
+            
+            // El lector detecta si el emisor usa tramas de texto o binarias
+            PuertoTramas puerto;
+            puerto.persistencia = persistencia;
+            puerto.handle = hSerial;
+            puerto.lector.configurarRotores(numRotores);
             
-            char buffer[256];
-            while (leerLineaSerial(hSerial, buffer, sizeof(buffer))) {
-                TramaBase* trama = parsearTrama(buffer);
-                if (trama) {
-                    trama->procesar(&miListaDeCarga, &miRotorDeMapeo);
-                    delete trama;
+            if (usarTuberia) {
+                procesarConTuberia(&puerto, &miListaDeCarga, &miRotorDeMapeo, modoProgreso, ventanaProgreso);
+            } else {
+                // Bucle sin memoria dinámica por trama: la trama vive en la pila
+                TramaValor trama;
+                while (leerTramaPuerto(&puerto, trama)) {
+                    aplicarTrama(trama, destino);
+                    PRT7_MEDIR(ETAPA_TOTAL, puerto.llegada);
                 }
             }
+            if (puerto.lector.getMalformadas() > 0) {
+                std::cout << std::endl << puerto.lector.getMalformadas() << " tramas mal formadas descartadas." << std::endl;
+            }
             
             CloseHandle(hSerial);
         }
     #else
-        nombrePuerto = "/dev/ttyUSB0"; // Cambiar según necesidad
-        int fd = abrirPuertoSerial(nombrePuerto);
+        int fd = abrirPuertoSerial(nombrePuerto, configuracionSerial, &bajaLatencia);
         
         if (fd == -1) {
             std::cout << "No se pudo abrir el puerto serial. Usando modo de prueba con datos simulados." << std::endl;
@@ -275,27 +797,43 @@ int main() {
                 "L,W", "M,-2", "L,O", "L,R", "L,L", "L,D", nullptr
             };
             
+            // Las tramas de prueba no van al diario: repetirlas en cada
+            // ejecución con --estado agregaría el mismo mensaje cada vez
+            DestinoTramas simulado = destino;
+            simulado.persistencia = nullptr;
+            TramaValor trama;
             for (int i = 0; tramasPrueba[i] != nullptr; i++) {
-                char buffer[256];
-                strcpy(buffer, tramasPrueba[i]);
-                
-                TramaBase* trama = parsearTrama(buffer);
-                if (trama) {
-                    trama->procesar(&miListaDeCarga, &miRotorDeMapeo);
-                    delete trama;
+                if (parsearTramaValor(tramasPrueba[i], trama)) {
+                    aplicarTrama(trama, simulado);
                 }
             }
         } else {
-            std::cout << "Conexion establecida. Esperando tramas..." << std::endl << std::endl;
+            std::cout << "Conexion establecida a " << configuracionSerial.baudios << " baudios. Esperando tramas..."
+                      << std::endl << std::endl;
+            if (configuracionSerial.bajaLatencia && !bajaLatencia) {
+                std::cout << "El controlador de " << nombrePuerto << " no admite baja latencia; se sigue sin ella."
+                          << std::endl;
+            }
+            
+            // El lector detecta si el emisor usa tramas de texto o binarias
+            PuertoTramas puerto;
+            puerto.persistencia = persistencia;
+            puerto.handle = fd;
+            puerto.lector.configurarRotores(numRotores);
             
-            char buffer[256];
-            while (leerLineaSerial(fd, buffer, sizeof(buffer))) {
-                TramaBase* trama = parsearTrama(buffer);
-                if (trama) {
-                    trama->procesar(&miListaDeCarga, &miRotorDeMapeo);
-                    delete trama;
+            if (usarTuberia) {
+                procesarConTuberia(&puerto, &miListaDeCarga, &miRotorDeMapeo, modoProgreso, ventanaProgreso);
+            } else {
+                // Bucle sin memoria dinámica por trama: la trama vive en la pila
+                TramaValor trama;
+                while (leerTramaPuerto(&puerto, trama)) {
+                    aplicarTrama(trama, destino);
+                    PRT7_MEDIR(ETAPA_TOTAL, puerto.llegada);
                 }
             }
+            if (puerto.lector.getMalformadas() > 0) {
+                std::cout << std::endl << puerto.lector.getMalformadas() << " tramas mal formadas descartadas." << std::endl;
+            }
             
             close(fd);
         }
@@ -305,9 +843,46 @@ int main() {
     std::cout << std::endl << "---" << std::endl;
     std::cout << "Flujo de datos terminado." << std::endl;
     std::cout << "MENSAJE OCULTO ENSAMBLADO:" << std::endl;
-    miListaDeCarga.imprimirMensaje();
+    if (sumidero) {
+        bool completo = miListaDeCarga.terminarFlujo();
+        if (strcmp(rutaFlujo, "-") == 0) {
+            std::cout << std::endl;
+        } else {
+            std::cout << "(" << miListaDeCarga.getEmitidos() << " fragmentos escritos en " << rutaFlujo << ")" << std::endl;
+        }
+        if (!completo) std::cout << "Fallaron escrituras al destino del flujo." << std::endl;
+    } else if (usarDiferida) {
+        miListaDiferida.imprimirMensaje();
+    } else {
+        miListaDeCarga.imprimirMensaje();
+    }
     std::cout << "---" << std::endl;
+    if (busqueda) {
+        std::cout << "Busqueda de \"" << busqueda->getPatron() << "\": "
+                  << busqueda->getCoincidencias() << " coincidencias";
+        if (busqueda->getOmitidos() > 0) {
+            std::cout << " (" << busqueda->getOmitidos() << " fragmentos emitidos sin revisar)";
+        }
+        std::cout << "." << std::endl;
+    }
+    if (nombreAnillo) {
+        std::cout << "Anillo " << nombreAnillo << ": " << anillo.getPublicados() << " eventos publicados." << std::endl;
+        // Los monitores abiertos conservan su mapeo y ven 'cerrado' al destruirse el anillo
+        PublicadorAnillo::eliminar(nombreAnillo);
+    }
+    if (reportarMemoria && usarDiferida) {
+        std::cout << "Memoria de carga: " << miListaDiferida.getBytesReservados() << " bytes para "
+                  << miListaDiferida.getLongitud() << " fragmentos en " << miListaDiferida.getNumEpocas()
+                  << " epocas (" << miListaDiferida.getBytesPorFragmento() << " bytes/fragmento)" << std::endl;
+    } else if (reportarMemoria) {
+        std::cout << "Memoria de carga: " << miListaDeCarga.getBytesReservados() << " bytes para "
+                  << miListaDeCarga.getLongitud() << " fragmentos ("
+                  << miListaDeCarga.getBytesPorFragmento() << " bytes/fragmento)" << std::endl;
+    }
     std::cout << "Liberando memoria... Sistema apagado." << std::endl;
     
+    delete busqueda;
+    delete sumidero;
+    
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+/**
+ * @file prueba_contexto.cpp
+ * @brief Prueba de ContextoDecodificacion: mismo mensaje sin importar cómo llegan los bytes
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Genera un flujo de tramas conocido (texto y binario, con uno y con
+ * varios rotores), calcula el mensaje esperado aplicando las tramas
+ * directamente a una CascadaRotores y lo compara con lo que drena un
+ * contexto al recibir el flujo en trozos de 1, 7 y 4096 bytes y entero.
+ * Lo mismo con ALFABETO_IMPRIMIBLE (minúsculas, dígitos y signos), cuya
+ * referencia es un RotorImprimible. Por último decodifica dos flujos a la
+ * vez, un contexto por hilo.
+ *
+ * Uso: prueba_contexto (lo ejecuta ctest); termina con 1 si algo falla.
+ */
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "ContextoDecodificacion.h"
+#include "CascadaRotores.h"
+#include "ParserTramas.h"
+#include "ProtocoloBinario.h"
+#include "RotorAlfabeto.h"
+#include "TramaValor.h"
+
+/**
+ * @brief Tramas entre dos bytes de sincronía en el flujo binario, como el generador
+ */
+static const int PERIODO_SINCRONIA = 256;
+
+/**
+ * @struct FlujoPrueba
+ * @brief Bytes de un flujo generado y lo que debe salir de decodificarlo
+ */
+struct FlujoPrueba {
+    std::string bytes;    ///< Flujo tal como llegaría del puerto
+    std::string esperado; ///< Mensaje decodificado esperado
+    long tramas;          ///< Tramas del flujo
+};
+
+/**
+ * @brief Genera un flujo pseudoaleatorio de tramas LOAD y MAP
+ * @param numTramas Tramas a generar
+ * @param numRotores Rotores de la cadena; los MAP van a cualquiera de ellos
+ * @param binario true para el formato binario, false para líneas de texto
+ * @param semilla Semilla del generador
+ * @param alfabeto Símbolos de las tramas LOAD; ALFABETO_IMPRIMIBLE usa un solo rotor
+ * @return Flujo con su mensaje esperado
+ */
+static FlujoPrueba generarFlujo(long numTramas, int numRotores, bool binario, unsigned long long semilla,
+                                AlfabetoTramas alfabeto = ALFABETO_MAYUSCULAS) {
+    FlujoPrueba flujo;
+    flujo.tramas = numTramas;
+    CascadaRotores referencia(numRotores);
+    RotorImprimible referenciaImprimible;
+    bool imprimible = alfabeto == ALFABETO_IMPRIMIBLE;
+    unsigned long long estado = semilla;
+    char buffer[PRT7_MAX_BYTES_LINEA + PRT7_MAX_BYTES_TRAMA];
+
+    for (long i = 0; i < numTramas; i++) {
+        estado = estado * 6364136223846793005ULL + 1442695040888963407ULL;
+        unsigned long long azar = estado >> 33;
+
+        TramaValor trama;
+        if (azar % 5 != 0) {
+            trama.tipo = TRAMA_LOAD;
+            trama.rotor = 0;
+            trama.rotacion = 0;
+            if (imprimible) {
+                trama.caracter = (char)(0x20 + azar / 5 % RotorImprimible::TAMANO);
+                flujo.esperado += referenciaImprimible.getMapeo(trama.caracter);
+            } else {
+                int simbolo = (int)(azar / 5 % 27);
+                trama.caracter = simbolo < 26 ? (char)('A' + simbolo) : ' ';
+                flujo.esperado += referencia.getMapeo(trama.caracter);
+            }
+        } else {
+            trama.tipo = TRAMA_MAP;
+            trama.caracter = 0;
+            trama.rotor = (unsigned char)(azar / 5 % numRotores);
+            trama.rotacion = (int)(azar / 5 / numRotores % 81) - 40;
+            if (imprimible) {
+                referenciaImprimible.rotar(trama.rotacion);
+            } else {
+                referencia.rotar(trama.rotor, trama.rotacion);
+            }
+        }
+
+        int n;
+        if (binario) {
+            if (i % PERIODO_SINCRONIA == 0) flujo.bytes += (char)PRT7_SINCRONIA;
+            n = codificarTramaBinaria(trama, reinterpret_cast<unsigned char*>(buffer));
+        } else {
+            n = formatearTramaTexto(trama, buffer);
+        }
+        flujo.bytes.append(buffer, n);
+    }
+    return flujo;
+}
+
+/**
+ * @brief Decodifica un flujo entregándolo a un contexto en trozos de tamaño fijo
+ * @param flujo Flujo a decodificar
+ * @param numRotores Rotores del contexto
+ * @param trozo Bytes por llamada a empujar(); 0 para entregarlo entero
+ * @param tramas Salida: tramas aplicadas
+ * @param malformadas Salida: tramas descartadas
+ * @param alfabeto Alfabeto del contexto
+ * @return Mensaje drenado
+ */
+static std::string decodificar(const FlujoPrueba& flujo, int numRotores, long trozo,
+                               long& tramas, long& malformadas,
+                               AlfabetoTramas alfabeto = ALFABETO_MAYUSCULAS) {
+    ContextoDecodificacion contexto(numRotores, false, alfabeto);
+    std::string mensaje;
+    char salida[512];
+    long total = (long)flujo.bytes.size();
+    if (trozo <= 0) trozo = total;
+
+    for (long inicio = 0; inicio < total; inicio += trozo) {
+        long n = (total - inicio < trozo) ? total - inicio : trozo;
+        contexto.empujar(flujo.bytes.data() + inicio, n);
+        long copiados;
+        while ((copiados = contexto.drenar(salida, sizeof(salida))) > 0) {
+            mensaje.append(salida, copiados);
+        }
+    }
+    tramas = contexto.getTramas();
+    malformadas = contexto.getMalformadas();
+    return mensaje;
+}
+
+/**
+ * @brief Compara lo decodificado con lo esperado y reporta la diferencia
+ * @param nombre Caso de prueba
+ * @param flujo Flujo decodificado
+ * @param mensaje Mensaje drenado
+ * @param tramas Tramas aplicadas
+ * @param malformadas Tramas descartadas
+ * @return true si coincide
+ */
+static bool verificar(const char* nombre, const FlujoPrueba& flujo, const std::string& mensaje,
+                      long tramas, long malformadas) {
+    bool correcto = mensaje == flujo.esperado && tramas == flujo.tramas && malformadas == 0;
+    if (!correcto) {
+        size_t i = 0;
+        while (i < mensaje.size() && i < flujo.esperado.size() && mensaje[i] == flujo.esperado[i]) i++;
+        printf("FALLO %s: %ld/%ld tramas, %ld mal formadas, %zu/%zu caracteres, difiere en %zu\n",
+               nombre, tramas, flujo.tramas, malformadas, mensaje.size(), flujo.esperado.size(), i);
+    }
+    return correcto;
+}
+
+int main() {
+    const long NUM_TRAMAS = 20000;
+    const long TROZOS[] = { 1, 7, 4096, 0 };
+    int fallos = 0;
+
+    for (int binario = 0; binario <= 1; binario++) {
+        for (int numRotores = 1; numRotores <= 3; numRotores += 2) {
+            FlujoPrueba flujo = generarFlujo(NUM_TRAMAS, numRotores, binario != 0, 7 + numRotores);
+            for (long trozo : TROZOS) {
+                char nombre[64];
+                snprintf(nombre, sizeof(nombre), "%s, %d rotores, trozos de %ld",
+                         binario ? "binario" : "texto", numRotores, trozo);
+                long tramas, malformadas;
+                std::string mensaje = decodificar(flujo, numRotores, trozo, tramas, malformadas);
+                if (!verificar(nombre, flujo, mensaje, tramas, malformadas)) fallos++;
+            }
+        }
+    }
+
+    // Firmware con minúsculas y dígitos: primero un caso escrito a mano
+    // ("M,1" lleva 'a' a 'b', '9' a ':' y el espacio a '!'; "M,-2" deja
+    // la cabeza en -1 y '~' pasa a '}')
+    FlujoPrueba manual;
+    manual.bytes = "L,h\nL,o\nL,l\nL,a\nM,1\nL,a\nL,9\nL,Space\nM,-2\nL,c\nL,~\n";
+    manual.esperado = "holab:!b}";
+    manual.tramas = 11;
+    for (long trozo : TROZOS) {
+        long tramas, malformadas;
+        std::string mensaje = decodificar(manual, 1, trozo, tramas, malformadas, ALFABETO_IMPRIMIBLE);
+        if (!verificar("imprimible escrito a mano", manual, mensaje, tramas, malformadas)) fallos++;
+    }
+    for (int binario = 0; binario <= 1; binario++) {
+        FlujoPrueba flujo = generarFlujo(NUM_TRAMAS, 1, binario != 0, 31 + binario, ALFABETO_IMPRIMIBLE);
+        for (long trozo : TROZOS) {
+            char nombre[64];
+            snprintf(nombre, sizeof(nombre), "imprimible %s, trozos de %ld", binario ? "binario" : "texto", trozo);
+            long tramas, malformadas;
+            std::string mensaje = decodificar(flujo, 1, trozo, tramas, malformadas, ALFABETO_IMPRIMIBLE);
+            if (!verificar(nombre, flujo, mensaje, tramas, malformadas)) fallos++;
+        }
+    }
+
+    // Dos contextos en dos hilos: cada uno sólo toca su propio estado
+    FlujoPrueba flujoTexto = generarFlujo(NUM_TRAMAS, 3, false, 101);
+    FlujoPrueba flujoBinario = generarFlujo(NUM_TRAMAS, 3, true, 202);
+    std::string mensajes[2];
+    long tramas[2], malformadas[2];
+    std::thread hiloTexto([&]() {
+        mensajes[0] = decodificar(flujoTexto, 3, 7, tramas[0], malformadas[0]);
+    });
+    std::thread hiloBinario([&]() {
+        mensajes[1] = decodificar(flujoBinario, 3, 7, tramas[1], malformadas[1]);
+    });
+    hiloTexto.join();
+    hiloBinario.join();
+    if (!verificar("hilo de texto", flujoTexto, mensajes[0], tramas[0], malformadas[0])) fallos++;
+    if (!verificar("hilo binario", flujoBinario, mensajes[1], tramas[1], malformadas[1])) fallos++;
+
+    if (fallos > 0) {
+        printf("%d casos fallaron.\n", fallos);
+        return 1;
+    }
+    printf("Todos los casos coinciden.\n");
+    return 0;
+}
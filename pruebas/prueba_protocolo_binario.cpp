@@ -0,0 +1,82 @@
+/**
+ * @file prueba_protocolo_binario.cpp
+ * @brief Prueba de DecodificadorBinario con rotaciones mal formadas
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Una rotación más larga que 32 bits se descarta entera: los bytes de
+ * continuación que quedan no deben leerse como tramas MAP nuevas, y la
+ * trama que sigue se decodifica normalmente.
+ *
+ * Uso: prueba_protocolo_binario (lo ejecuta ctest); termina con 1 si algo falla.
+ */
+
+#include <cstdio>
+#include "ProtocoloBinario.h"
+#include "TramaValor.h"
+
+/**
+ * @brief Tramas que entrega el decodificador para una secuencia de bytes
+ * @param bytes Secuencia a decodificar
+ * @param n Cantidad de bytes
+ * @param tramas Destino de las tramas completadas
+ * @param maxTramas Capacidad de tramas
+ * @param malformadas Salida: tramas descartadas
+ * @return Tramas completadas
+ */
+static int decodificar(const unsigned char* bytes, int n, TramaValor* tramas, int maxTramas,
+                       long& malformadas) {
+    DecodificadorBinario decodificador;
+    int completadas = 0;
+    TramaValor trama;
+    for (int i = 0; i < n; i++) {
+        if (decodificador.empujar(bytes[i], trama) && completadas < maxTramas) {
+            tramas[completadas++] = trama;
+        }
+    }
+    malformadas = decodificador.getMalformadas();
+    return completadas;
+}
+
+int main() {
+    int fallos = 0;
+    TramaValor tramas[16];
+    long malformadas;
+
+    // MAP con continuación en todos sus bytes: pasa de 32 bits en el quinto
+    // byte y todavía le siguen dos más antes del que la termina
+    const unsigned char larga[] = { PRT7_SINCRONIA, 0xC1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 'A' };
+    int n = decodificar(larga, (int)sizeof(larga), tramas, 16, malformadas);
+    if (n != 1 || tramas[0].tipo != TRAMA_LOAD || tramas[0].caracter != 'A' || malformadas != 1) {
+        printf("FALLO rotacion demasiado larga: %d tramas, %ld mal formadas\n", n, malformadas);
+        fallos++;
+    }
+
+    // La sincronía también cierra una rotación descartada
+    const unsigned char conSincronia[] = { 0xC1, 0xFF, 0xFF, 0xFF, 0xFF, PRT7_SINCRONIA, 'B' };
+    n = decodificar(conSincronia, (int)sizeof(conSincronia), tramas, 16, malformadas);
+    if (n != 1 || tramas[0].tipo != TRAMA_LOAD || tramas[0].caracter != 'B' || malformadas != 1) {
+        printf("FALLO rotacion cortada por sincronia: %d tramas, %ld mal formadas\n", n, malformadas);
+        fallos++;
+    }
+
+    // Una rotación válida después de la descartada se aplica tal cual
+    unsigned char valida[32] = { 0xC1, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 };
+    int largo = 6;
+    TramaValor map = { TRAMA_MAP, 0, 0, -300 };
+    largo += codificarTramaBinaria(map, valida + largo);
+    valida[largo++] = 'C';
+    n = decodificar(valida, largo, tramas, 16, malformadas);
+    if (n != 2 || tramas[0].tipo != TRAMA_MAP || tramas[0].rotacion != -300 ||
+        tramas[1].tipo != TRAMA_LOAD || tramas[1].caracter != 'C' || malformadas != 1) {
+        printf("FALLO rotacion valida tras la descartada: %d tramas, %ld mal formadas\n", n, malformadas);
+        fallos++;
+    }
+
+    if (fallos > 0) {
+        printf("%d casos fallaron.\n", fallos);
+        return 1;
+    }
+    printf("Todos los casos coinciden.\n");
+    return 0;
+}